@@ -0,0 +1,202 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_ASYNC.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Asynchronous read/write operations for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * The completed writes are pushed by the ISR on a lock-free stack (compare-and-swap), the task
+ * takes the whole stack with one exchange and calls the callbacks in completion order. The
+ * pending reads are a list only touched by the task, the ISR only checks that it is not empty.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_ASYNC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+
+_Static_assert(!USB_SERIAL_JTAG_CFG_ASYNC_ENABLE || USB_SERIAL_JTAG_CFG_TXQ_ENABLE, "Async operations require the TX descriptor queue");
+
+static __usbSerialJtag_asyncNotify_t notifyHook = NULL;
+static void *notifyArg = NULL;
+static __usbSerialJtag_asyncOp_t *completed = NULL; // Pushed by the ISR, taken by the task
+static __usbSerialJtag_asyncOp_t *readHead = NULL; // Written by the task, tested by the ISR
+static __usbSerialJtag_asyncOp_t *readTail = NULL; // Task only
+
+#define mASYNC_WRITE_CANCELLED 0x80000000UL // flags of a write dropped by a bus reset (set by the ISR)
+
+
+static void asyncNotify(void)
+{
+    if (notifyHook != NULL) {
+        notifyHook(notifyArg);
+    }
+}
+
+static void asyncOnWriteDone(__usbSerialJtag_txqDesc_t *desc, void *arg, uint32_t status)
+{
+    __usbSerialJtag_asyncOp_t *op = (__usbSerialJtag_asyncOp_t *) arg;
+    __usbSerialJtag_asyncOp_t *top = __atomic_load_n(&completed, __ATOMIC_RELAXED);
+
+    op->done = desc->sent;
+    if (status == kUSB_SERIAL_JTAG_TXQ_CANCELLED) {
+        op->flags |= mASYNC_WRITE_CANCELLED;
+    }
+    do {
+        op->next = top;
+    } while (!__atomic_compare_exchange_n(&completed, &top, op, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    asyncNotify();
+}
+
+// Move the RX ring to the read at the head, 1 once it can complete. A read left pending stops on
+// a 0 return, the ISR notifies the next data it moves to the ring
+static uint32_t asyncServe(__usbSerialJtag_asyncOp_t *op)
+{
+    for (;;) {
+        uint32_t got = (uint32_t) usbSerialJtag_isrRead(&op->buf[op->done], op->len - op->done);
+        op->done += got;
+        if (op->flags & mUSB_SERIAL_JTAG_ASYNC_ALL) {
+            if (op->done == op->len) {
+                return 1;
+            }
+        } else if (op->done != 0) {
+            return 1;
+        }
+        if (got == 0) {
+            return 0;
+        }
+    }
+}
+
+static void asyncComplete(__usbSerialJtag_asyncOp_t *op, int32_t status)
+{
+    op->status = status;
+    if (op->cb != NULL) {
+        op->cb(op, op->arg);
+    }
+}
+
+static __usbSerialJtag_asyncOp_t *asyncPopRead(void)
+{
+    __usbSerialJtag_asyncOp_t *op = readHead;
+
+    __atomic_store_n(&readHead, op->next, __ATOMIC_RELAXED);
+    if (readHead == NULL) {
+        readTail = NULL;
+    }
+    return op;
+}
+
+
+void usbSerialJtag_asyncInit(__usbSerialJtag_asyncNotify_t notify, void *arg)
+{
+    notifyHook = notify;
+    notifyArg = arg;
+    readTail = NULL;
+    __atomic_store_n(&readHead, NULL, __ATOMIC_RELAXED);
+    __atomic_store_n(&completed, NULL, __ATOMIC_RELEASE);
+}
+
+int usbSerialJtag_asyncWrite(__usbSerialJtag_asyncOp_t *op, const uint8_t *buf, uint32_t len, __usbSerialJtag_asyncCallback_t cb, void *arg)
+{
+    op->buf = NULL;
+    op->len = len;
+    op->flags = 0;
+    op->done = 0;
+    op->status = kUSB_SERIAL_JTAG_ASYNC_PENDING;
+    op->cb = cb;
+    op->arg = arg;
+    op->seg.ptr = buf;
+    op->seg.len = len;
+    op->desc.segs = &op->seg;
+    op->desc.count = 1;
+    op->desc.done = asyncOnWriteDone;
+    op->desc.arg = op;
+
+    if (usbSerialJtag_txqSubmit(&op->desc) != 0) {
+        op->status = kUSB_SERIAL_JTAG_ASYNC_CANCELLED;
+        return -1;
+    }
+    return 0;
+}
+
+int usbSerialJtag_asyncRead(__usbSerialJtag_asyncOp_t *op, uint8_t *buf, uint32_t len, uint32_t flags, __usbSerialJtag_asyncCallback_t cb, void *arg)
+{
+    if (len == 0) {
+        op->done = 0;
+        op->status = kUSB_SERIAL_JTAG_ASYNC_CANCELLED;
+        return -1;
+    }
+    op->buf = buf;
+    op->len = len;
+    op->flags = flags;
+    op->done = 0;
+    op->cb = cb;
+    op->arg = arg;
+    op->next = NULL;
+
+    if (readHead == NULL && asyncServe(op)) {
+        op->status = kUSB_SERIAL_JTAG_ASYNC_DONE;
+        return 1;
+    }
+
+    op->status = kUSB_SERIAL_JTAG_ASYNC_PENDING;
+    if (readTail != NULL) {
+        readTail->next = op;
+    } else {
+        __atomic_store_n(&readHead, op, __ATOMIC_RELAXED);
+    }
+    readTail = op;
+    return 0;
+}
+
+uint32_t usbSerialJtag_asyncPoll(void)
+{
+    uint32_t count = 0;
+
+    // A callback can start a new read, it is served by the same loop
+    while (readHead != NULL && asyncServe(readHead)) {
+        asyncComplete(asyncPopRead(), kUSB_SERIAL_JTAG_ASYNC_DONE);
+        count++;
+    }
+
+    // The stack is in reverse completion order
+    __usbSerialJtag_asyncOp_t *op = __atomic_exchange_n(&completed, NULL, __ATOMIC_ACQUIRE);
+    __usbSerialJtag_asyncOp_t *list = NULL;
+    while (op != NULL) {
+        __usbSerialJtag_asyncOp_t *next = op->next;
+        op->next = list;
+        list = op;
+        op = next;
+    }
+    while (list != NULL) {
+        op = list;
+        list = op->next;
+        asyncComplete(op, (op->flags & mASYNC_WRITE_CANCELLED) ? kUSB_SERIAL_JTAG_ASYNC_CANCELLED : kUSB_SERIAL_JTAG_ASYNC_DONE);
+        count++;
+    }
+
+    return count;
+}
+
+void usbSerialJtag_asyncCancelReads(void)
+{
+    // The list is detached first, a callback can start new reads
+    __usbSerialJtag_asyncOp_t *op = readHead;
+
+    readTail = NULL;
+    __atomic_store_n(&readHead, NULL, __ATOMIC_RELAXED);
+    while (op != NULL) {
+        __usbSerialJtag_asyncOp_t *next = op->next;
+        asyncComplete(op, kUSB_SERIAL_JTAG_ASYNC_CANCELLED);
+        op = next;
+    }
+}
+
+void usbSerialJtag_asyncOnRx(void)
+{
+    if (__atomic_load_n(&readHead, __ATOMIC_RELAXED) != NULL) {
+        asyncNotify();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_ASYNC.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Asynchronous read/write operations for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates non-blocking operations on the CDC-ACM channel. An operation is
+ * started with usbSerialJtag_asyncWrite or usbSerialJtag_asyncRead and its completion callback is
+ * called later, so one task can serve the channel together with other event sources instead of
+ * spending a task stack blocked on the FIFO.
+ *
+ * The writes are descriptors of the TX descriptor queue, they complete on the SERIAL_IN_EMPTY_INT
+ * that pushes their last byte. The reads are served from the RX ring once SERIAL_OUT_RECV_PKT_INT
+ * has moved data to it. The ISR does not call the completion callbacks: it records the event and
+ * calls the notify hook (e.g. xEventGroupSetBitsFromISR or vTaskNotifyGiveFromISR), the task then
+ * calls usbSerialJtag_asyncPoll and the callbacks run in its context:
+ *
+ *     usbSerialJtag_asyncInit(notifyFromIsr, group);
+ *     usbSerialJtag_asyncRead(&rx, buf, sizeof(buf), 0, onRx, NULL);
+ *     for (;;) {
+ *         xEventGroupWaitBits(group, USB_BIT | OTHER_BITS, pdTRUE, pdFALSE, portMAX_DELAY);
+ *         usbSerialJtag_asyncPoll();
+ *         ...
+ *     }
+ *
+ * The C++20 awaitables of USB_SERIAL_JTAG_ESP32-C6_ASYNC.hpp are built on the same operations.
+ *
+ * The operations are serviced by usbSerialJtag_isrHandler when USB_SERIAL_JTAG_CFG_ASYNC_ENABLE
+ * is 1 (USB_SERIAL_JTAG_CFG_TXQ_ENABLE is required). All the functions but the notify hook are
+ * called from the one task that owns the channel.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_ASYNC_H
+#define USB_SERIAL_JTAG_ESP32_C6_ASYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_TXQ.h"
+
+/**
+ * Status of an operation
+ */
+#define kUSB_SERIAL_JTAG_ASYNC_DONE 0 // Completed, done holds the number of bytes transferred
+#define kUSB_SERIAL_JTAG_ASYNC_PENDING 1 // Started and not completed yet
+#define kUSB_SERIAL_JTAG_ASYNC_CANCELLED (-1) // Not started, cancelled by usbSerialJtag_asyncCancelReads or write dropped by a bus reset (done holds the bytes pushed)
+
+/**
+ * Flags of usbSerialJtag_asyncRead
+ */
+#define mUSB_SERIAL_JTAG_ASYNC_ALL 0x00000001UL // Complete once the whole buffer is filled, not on the first bytes
+
+typedef struct __usbSerialJtag_asyncOp __usbSerialJtag_asyncOp_t;
+
+/**
+ * \typedef __usbSerialJtag_asyncCallback_t
+ * Completion callback of an operation, called from usbSerialJtag_asyncPoll (task context)
+ */
+typedef void (*__usbSerialJtag_asyncCallback_t)(__usbSerialJtag_asyncOp_t *op, void *arg);
+
+/**
+ * \typedef __usbSerialJtag_asyncNotify_t
+ * Notify hook, called from the ISR when usbSerialJtag_asyncPoll has work to do
+ */
+typedef void (*__usbSerialJtag_asyncNotify_t)(void *arg);
+
+/**
+ * \typedef __usbSerialJtag_asyncOp_t
+ * Operation, owned by the driver from its start until its completion callback
+ */
+struct __usbSerialJtag_asyncOp {
+    uint8_t *buf; // Destination of a read (NULL for a write)
+    uint32_t len; // Length of the buffer in bytes
+    uint32_t flags; // mUSB_SERIAL_JTAG_ASYNC_xxx flags of a read
+    uint32_t done; // Bytes transferred
+    volatile int32_t status; // kUSB_SERIAL_JTAG_ASYNC_xxx
+    __usbSerialJtag_asyncCallback_t cb; // Completion callback (can be NULL)
+    void *arg; // Argument of the completion callback
+
+    // Private to the driver
+    __usbSerialJtag_txqSeg_t seg;
+    __usbSerialJtag_txqDesc_t desc;
+    __usbSerialJtag_asyncOp_t *next;
+};
+
+
+/**
+ * @brief Reset the operation lists and set the notify hook (no operation may be pending)
+ *
+ * @param notify Hook called from the ISR when an operation can progress (can be NULL to poll)
+ * @param arg Argument of the notify hook
+ */
+void usbSerialJtag_asyncInit(__usbSerialJtag_asyncNotify_t notify, void *arg);
+
+/**
+ * @brief Start a write, the data is streamed from buf that must stay valid until completion
+ *
+ * @param op Operation
+ * @param buf Pointer to the data to be sent
+ * @param len Number of bytes to be sent
+ * @param cb Completion callback (can be NULL)
+ * @param arg Argument of the completion callback
+ * @return int 0 on success, -1 if the TX descriptor queue is full (status is kUSB_SERIAL_JTAG_ASYNC_CANCELLED)
+ */
+int usbSerialJtag_asyncWrite(__usbSerialJtag_asyncOp_t *op, const uint8_t *buf, uint32_t len, __usbSerialJtag_asyncCallback_t cb, void *arg);
+
+/**
+ * @brief Start a read, the reads complete in the order they are started
+ *
+ * When no other read is pending and the RX ring already holds enough data the read completes at
+ * once: the call returns 1 and the callback is not called.
+ *
+ * @param op Operation
+ * @param buf Pointer to the buffer where the data is stored
+ * @param len Size of the buffer (at least 1)
+ * @param flags 0 to complete on the first bytes received, mUSB_SERIAL_JTAG_ASYNC_ALL to fill the buffer
+ * @param cb Completion callback (can be NULL)
+ * @param arg Argument of the completion callback
+ * @return int 0 if the read is pending, 1 if it completed at once, -1 if len is 0 (status is kUSB_SERIAL_JTAG_ASYNC_CANCELLED)
+ */
+int usbSerialJtag_asyncRead(__usbSerialJtag_asyncOp_t *op, uint8_t *buf, uint32_t len, uint32_t flags, __usbSerialJtag_asyncCallback_t cb, void *arg);
+
+/**
+ * @brief Serve the pending reads and call the completion callbacks (task context)
+ *
+ * @return uint32_t Number of operations completed
+ */
+uint32_t usbSerialJtag_asyncPoll(void);
+
+/**
+ * @brief Complete the pending reads with kUSB_SERIAL_JTAG_ASYNC_CANCELLED (bytes already stored are kept in done)
+ */
+void usbSerialJtag_asyncCancelReads(void);
+
+/**
+ * @brief SERIAL_OUT_RECV_PKT_INT hook, notifies the task when a read is pending (ISR side)
+ */
+void usbSerialJtag_asyncOnRx(void);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_ASYNC_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_ASYNC.hpp
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Awaitable read/write operations for the ESP32-C6 USB Serial JTAG Controller (C++20)
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file wraps the operations of USB_SERIAL_JTAG_ESP32-C6_ASYNC.h in awaitables. The
+ * operation lives in the frame of the awaiting coroutine, which is resumed from
+ * usbSerialJtag_asyncPoll once the operation completes, so no heap and no task stack is used:
+ *
+ *     Task echo()
+ *     {
+ *         uint8_t buf[64];
+ *         for (;;) {
+ *             int32_t n = co_await usbSerialJtag::asyncRead(buf, sizeof(buf));
+ *             if (n > 0) {
+ *                 co_await usbSerialJtag::asyncWrite(buf, (uint32_t) n);
+ *             }
+ *         }
+ *     }
+ *
+ * co_await yields the number of bytes transferred, or -1 when the operation could not be started
+ * or was cancelled.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_ASYNC_HPP
+#define USB_SERIAL_JTAG_ESP32_C6_ASYNC_HPP
+
+#if __cplusplus < 202002L
+#error "USB_SERIAL_JTAG_ESP32-C6_ASYNC.hpp requires C++20"
+#endif
+
+#include <coroutine>
+#include <stdint.h>
+
+extern "C" {
+#include "USB_SERIAL_JTAG_ESP32-C6_ASYNC.h"
+}
+
+namespace usbSerialJtag {
+
+/**
+ * Common part of the awaiters, resumes the coroutine from the completion callback
+ */
+class AsyncAwaiter {
+public:
+    AsyncAwaiter(const AsyncAwaiter &) = delete;
+    AsyncAwaiter &operator=(const AsyncAwaiter &) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    int32_t await_resume() const noexcept
+    {
+        return (op.status == kUSB_SERIAL_JTAG_ASYNC_DONE) ? (int32_t) op.done : -1;
+    }
+
+protected:
+    AsyncAwaiter() = default;
+
+    static void resume(__usbSerialJtag_asyncOp_t *, void *arg)
+    {
+        static_cast<AsyncAwaiter *>(arg)->handle.resume();
+    }
+
+    __usbSerialJtag_asyncOp_t op{};
+    std::coroutine_handle<> handle;
+};
+
+/**
+ * Awaitable write, completes once the last byte is in the FIFO (buf must stay valid until then)
+ */
+class WriteAwaiter : public AsyncAwaiter {
+public:
+    WriteAwaiter(const uint8_t *buf, uint32_t len) : buf(buf), len(len) {}
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept
+    {
+        handle = h;
+        // Not suspended when the descriptor queue is full, await_resume returns -1
+        return usbSerialJtag_asyncWrite(&op, buf, len, resume, this) == 0;
+    }
+
+private:
+    const uint8_t *buf;
+    uint32_t len;
+};
+
+/**
+ * Awaitable read, completes on the first bytes received or, with all, once buf is full
+ */
+class ReadAwaiter : public AsyncAwaiter {
+public:
+    ReadAwaiter(uint8_t *buf, uint32_t len, bool all = false) : buf(buf), len(len), all(all) {}
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept
+    {
+        handle = h;
+        // Not suspended when the read completes at once, or when len is 0 (await_resume returns -1)
+        return usbSerialJtag_asyncRead(&op, buf, len, all ? mUSB_SERIAL_JTAG_ASYNC_ALL : 0U, resume, this) == 0;
+    }
+
+private:
+    uint8_t *buf;
+    uint32_t len;
+    bool all;
+};
+
+/**
+ * @brief Write buf to the CDC-ACM channel, co_await yields len or -1
+ */
+inline WriteAwaiter asyncWrite(const uint8_t *buf, uint32_t len) { return WriteAwaiter(buf, len); }
+
+/**
+ * @brief Read from the CDC-ACM channel, co_await yields the number of bytes read or -1
+ */
+inline ReadAwaiter asyncRead(uint8_t *buf, uint32_t len, bool all = false) { return ReadAwaiter(buf, len, all); }
+
+} // namespace usbSerialJtag
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_ASYNC_HPP
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_BLOG.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Deferred formatting binary log for the CDC-ACM channel of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include <stddef.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_BLOG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_LOG.h"
+#else
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+#endif
+
+_Static_assert(USB_SERIAL_JTAG_CFG_BLOG_MAX_ARGS <= 15U, "A binary log record holds up to 15 arguments");
+
+#define kBLOG_MAX_RECORD (kUSB_SERIAL_JTAG_BLOG_HDR_SIZE + 4U * USB_SERIAL_JTAG_CFG_BLOG_MAX_ARGS)
+#define mBLOG_SEQ 0x0000FFFFUL
+
+static uint32_t tsState = 0; // Frame index (bits 16-26) and sequence number (bits 0-15) of the last record
+
+
+static inline void put16(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t) value;
+    dst[1] = (uint8_t) (value >> 8);
+}
+
+static inline void put32(uint8_t *dst, uint32_t value)
+{
+    put16(dst, value);
+    put16(&dst[2], value >> 16);
+}
+
+static void blogEncode(uint8_t *rec, uint32_t fmtAddr, uint32_t nargs, const uint32_t *args)
+{
+    rec[0] = (uint8_t) (kUSB_SERIAL_JTAG_BLOG_TAG | nargs);
+    put16(&rec[1], fmtAddr);
+    put32(&rec[3], usbSerialJtag_blogTimestamp());
+    for (uint32_t i = 0; i < nargs; i++) {
+        put32(&rec[kUSB_SERIAL_JTAG_BLOG_HDR_SIZE + 4U * i], args[i]);
+    }
+}
+
+
+uint32_t usbSerialJtag_blogTimestamp(void)
+{
+    uint32_t frame = usbSerialJtag_framNumSnapshot().BITS.SOF_FRAME_INDEX;
+    uint32_t old = __atomic_load_n(&tsState, __ATOMIC_RELAXED);
+    uint32_t next;
+
+    do {
+        if ((old >> 16) != frame) {
+            next = frame << 16;
+        } else if ((old & mBLOG_SEQ) != mBLOG_SEQ) {
+            next = old + 1U;
+        } else {
+            next = old; // Saturated until the next frame
+        }
+    } while (!__atomic_compare_exchange_n(&tsState, &old, next, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    return next;
+}
+
+uint32_t usbSerialJtag_blogFloat(float value)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = { .f = value };
+
+    return bits.u;
+}
+
+int usbSerialJtag_blogWrite(uint32_t fmtAddr, uint32_t nargs, const uint32_t *args)
+{
+    if (nargs > USB_SERIAL_JTAG_CFG_BLOG_MAX_ARGS) {
+        return -1;
+    }
+
+    uint32_t len = kUSB_SERIAL_JTAG_BLOG_HDR_SIZE + 4U * nargs;
+
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+    // Encoded in place, the record is sent whole
+    uint8_t *rec = usbSerialJtag_logReserve(len);
+    if (rec == NULL) {
+        return -1;
+    }
+    blogEncode(rec, fmtAddr, nargs, args);
+    usbSerialJtag_logCommit(rec);
+#else
+    // A partial record would desynchronize the host decoder: all or nothing
+    uint8_t rec[kBLOG_MAX_RECORD];
+    if (usbSerialJtag_isrTxFree() < len) {
+        return -1;
+    }
+    blogEncode(rec, fmtAddr, nargs, args);
+    (void) usbSerialJtag_isrWrite(rec, len);
+#endif
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_BLOG.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Deferred formatting binary log for the CDC-ACM channel of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the binary log. USB_SERIAL_JTAG_BLOG places the format string in the
+ * .usbSerialJtagFmt section and sends a record with the string ID and the raw argument words, the
+ * string is expanded on the host by tools/usb_serial_jtag_blog.py from the ELF file of the
+ * application. No formatting is done on the device.
+ *
+ * The section is not needed at run time, the linker script keeps it out of the image:
+ *
+ *     .usbSerialJtagFmt 0 (INFO) : { KEEP(*(.usbSerialJtagFmt)) }
+ *
+ * The ID of a string is the low 16 bits of its address, so the table is limited to 64 KiB.
+ *
+ * Record, little endian (7 + 4 * N bytes):
+ *
+ *     0xA0 | N, ID (u16), timestamp (u32), N argument words (u32)
+ *
+ * The timestamp is the SOF frame index (bits 16-26) and a sequence number of the records of that
+ * frame (bits 0-15), so the records of one frame keep their order.
+ *
+ * The arguments are integers or pointers, a float is passed through usbSerialJtag_blogFloat.
+ * The records go through the multi-producer log ring when USB_SERIAL_JTAG_CFG_LOG_ENABLE is 1
+ * (any context), otherwise through the TX ring of the interrupt driver (single producer).
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_BLOG_H
+#define USB_SERIAL_JTAG_ESP32_C6_BLOG_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+
+/**
+ * Constant definitions for the binary log records
+ */
+#define kUSB_SERIAL_JTAG_BLOG_TAG 0xA0U // High nibble of the first byte of a record
+#define kUSB_SERIAL_JTAG_BLOG_HDR_SIZE 7U // Tag, ID and timestamp
+
+/**
+ * @brief Send a binary log record, fmt must be a string literal
+ */
+#define USB_SERIAL_JTAG_BLOG(fmt, ...)                                                                              \
+    do {                                                                                                            \
+        static const char usjBlogFmt[] __attribute__((section(".usbSerialJtagFmt"), used)) = fmt;                    \
+        const uint32_t usjBlogArgs[] = { 0, ##__VA_ARGS__ };                                                        \
+        usbSerialJtag_blogWrite((uint32_t) (uintptr_t) usjBlogFmt, (uint32_t) (sizeof(usjBlogArgs) / sizeof(uint32_t)) - 1U, \
+                                &usjBlogArgs[1]);                                                                   \
+    } while (0)
+
+
+/**
+ * @brief Get the timestamp of a new record (SOF frame index and sequence number in the frame)
+ *
+ * @return uint32_t Timestamp
+ */
+uint32_t usbSerialJtag_blogTimestamp(void);
+
+/**
+ * @brief Pass a float argument as its bit pattern
+ */
+uint32_t usbSerialJtag_blogFloat(float value);
+
+/**
+ * @brief Send a binary log record, used by USB_SERIAL_JTAG_BLOG
+ *
+ * @param fmtAddr Address of the format string
+ * @param nargs Number of argument words (up to USB_SERIAL_JTAG_CFG_BLOG_MAX_ARGS)
+ * @param args Argument words
+ * @return int 0 on success, -1 if the record was dropped (ring full or too many arguments)
+ */
+int usbSerialJtag_blogWrite(uint32_t fmtAddr, uint32_t nargs, const uint32_t *args);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_BLOG_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_CDC.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Bulk CDC-ACM data path for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_FIFO.h"
+
+static uint32_t rxLeft = 0; // Bytes of the current OUT packet still in the FIFO
+static uint32_t rxPackets = 0; // OUT packets started
+
+
+uint32_t usbSerialJtag_txFree(__usbSerialJtag_t *hw)
+{
+    __usbSerialJtag_ep1ConfReg_t conf = { .WORD = usbSerialJtag_hwRegRead(hw, ep1ConfReg) };
+    if (conf.BITS.SERIAL_IN_EP_DATA_FREE == 0) {
+        return 0;
+    }
+
+    // WR_ADDR and RD_ADDR are taken from the same read, so the occupancy is consistent
+    __usbSerialJtag_inEpxStReg_t st = { .WORD = usbSerialJtag_hwRegRead(hw, inEp1StReg) };
+    uint32_t used = (st.BITS.IN_EPX_WR_ADDR - st.BITS.IN_EPX_RD_ADDR) & kUSB_SERIAL_JTAG_EP_ADDR_MASK;
+
+    if (used >= kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE) {
+        return 0;
+    }
+    return kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE - used;
+}
+
+void usbSerialJtag_txPush(__usbSerialJtag_t *hw, const uint8_t *buf, size_t len)
+{
+    if (len == kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE && ((uintptr_t) buf & 3U) == 0) {
+        // Whole aligned packet (pool buffers, full ring spans)
+        usbSerialJtag_fifoPush64(hw, buf);
+        return;
+    }
+    usbSerialJtag_fifoPush(hw, buf, (uint32_t) len);
+}
+
+void usbSerialJtag_txFlush(__usbSerialJtag_t *hw)
+{
+    usbSerialJtag_hwRegWrite(hw, ep1ConfReg, mUSBSERIALJTAG_EP1CONFREG_WR_DONE);
+}
+
+size_t usbSerialJtag_write(__usbSerialJtag_t *hw, const uint8_t *buf, size_t len)
+{
+    size_t sent = 0;
+
+    while (sent < len) {
+        uint32_t space = usbSerialJtag_txFree(hw);
+        if (space == 0) {
+            break;
+        }
+
+        size_t chunk = len - sent;
+        if (chunk > space) {
+            chunk = space;
+        }
+
+        // Burst the packet into the FIFO, the free space is already known
+        usbSerialJtag_txPush(hw, &buf[sent], chunk);
+        sent += chunk;
+
+        // One WR_DONE per packet: full packets while data remains, a short one only for the tail
+        usbSerialJtag_txFlush(hw);
+    }
+
+    return sent;
+}
+
+size_t usbSerialJtag_read(__usbSerialJtag_t *hw, uint8_t *buf, size_t max)
+{
+    size_t got = 0;
+
+    while (got < max) {
+        if (rxLeft == 0) {
+            __usbSerialJtag_ep1ConfReg_t conf = { .WORD = usbSerialJtag_hwRegRead(hw, ep1ConfReg) };
+            if (conf.BITS.SERIAL_OUT_EP_DATA_AVAIL == 0) {
+                break;
+            }
+            // The count is latched once per packet, it is not the number of bytes left: a packet
+            // whose count is not latched yet is left in the FIFO and started by the next call
+            __usbSerialJtag_outEpxStReg_t st = { .WORD = usbSerialJtag_hwRegRead(hw, outEp1StReg) };
+            rxLeft = st.BITS.EP1_REC_DATA_CNT;
+            if (rxLeft == 0) {
+                break;
+            }
+            rxPackets++;
+        }
+
+        size_t chunk = max - got;
+        if (chunk > rxLeft) {
+            chunk = rxLeft;
+        }
+
+        // Drain the packet, its length is already known
+        usbSerialJtag_fifoPull(hw, &buf[got], (uint32_t) chunk);
+        got += chunk;
+        rxLeft -= (uint32_t) chunk;
+    }
+
+    return got;
+}
+
+uint32_t usbSerialJtag_rxPacketCount(void)
+{
+    return rxPackets;
+}
+
+void usbSerialJtag_rxReset(void)
+{
+    rxLeft = 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_CDC.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Bulk CDC-ACM data path for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the bulk transfer functions for the CDC-ACM IN/OUT endpoint (EP1)
+ * of the USB Serial JTAG Controller. The functions are built on top of the register definitions
+ * of USB_SERIAL_JTAG_ESP32-C6_LIB.h and move whole packets per status read instead of a single
+ * byte per status read.
+ *
+ * All the functions are non-blocking: they move as many bytes as the hardware accepts at the
+ * moment of the call and return the number of bytes moved.
+ *
+ * The data functions take the register block (usbSerialJtag_hw) and access the status registers
+ * and the EP1 FIFO through it. The OUT packet in progress is tracked once, for the single
+ * controller of the chip.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_CDC_H
+#define USB_SERIAL_JTAG_ESP32_C6_CDC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Constant definitions for the CDC-ACM data endpoint (EP1)
+ */
+#define kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE 64U // Max packet size of the CDC-ACM bulk IN/OUT endpoint (Full-Speed)
+#define kUSB_SERIAL_JTAG_EP_ADDR_MASK 0x7FU // Width mask of the WR_ADDR/RD_ADDR endpoint pointers (7 bits)
+
+
+/**
+ * @brief Get the free space of the CDC-ACM IN FIFO (EP1 IN)
+ *
+ * The free space is computed from the WR_ADDR and RD_ADDR pointers of inEp1StReg with a single read
+ * of the status register. It returns 0 when SERIAL_IN_EP_DATA_FREE is not set (a packet is waiting
+ * to be read by the host).
+ *
+ * @param hw Register block
+ * @return uint32_t Number of bytes that can be pushed to the FIFO without checking the status
+ */
+uint32_t usbSerialJtag_txFree(__usbSerialJtag_t *hw);
+
+/**
+ * @brief Push bytes to the CDC-ACM IN FIFO without status checks and without committing the packet
+ *
+ * The caller is responsible for not pushing more bytes than reported by usbSerialJtag_txFree.
+ *
+ * @param hw Register block
+ * @param buf Pointer to the data to be pushed
+ * @param len Number of bytes to be pushed
+ */
+void usbSerialJtag_txPush(__usbSerialJtag_t *hw, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Commit the bytes pushed to the CDC-ACM IN FIFO as one packet (WR_DONE)
+ *
+ * @param hw Register block
+ */
+void usbSerialJtag_txFlush(__usbSerialJtag_t *hw);
+
+/**
+ * @brief Write a buffer to the CDC-ACM IN endpoint (EP1 IN)
+ *
+ * The buffer is split in packets of up to kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE bytes. Each packet
+ * is pushed to the FIFO without status reads in between bytes and is committed with a single
+ * WR_DONE, so a short packet is only sent for the tail of the buffer.
+ *
+ * @param hw Register block
+ * @param buf Pointer to the data to be sent
+ * @param len Number of bytes to be sent
+ * @return size_t Number of bytes accepted by the FIFO (0 if the FIFO is full)
+ */
+size_t usbSerialJtag_write(__usbSerialJtag_t *hw, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Read from the CDC-ACM OUT endpoint (EP1 OUT)
+ *
+ * The length of every received packet is read once from EP1_REC_DATA_CNT and the packet is drained
+ * without status reads in between bytes. When max is smaller than the packet, the remaining bytes
+ * are kept in the FIFO and returned by the next call. A packet flagged by SERIAL_OUT_EP_DATA_AVAIL
+ * before its count is latched is not read, the next call takes it.
+ *
+ * @param hw Register block
+ * @param buf Pointer to the buffer where the data is stored
+ * @param max Size of the buffer
+ * @return size_t Number of bytes read (0 if there is no data available)
+ */
+size_t usbSerialJtag_read(__usbSerialJtag_t *hw, uint8_t *buf, size_t max);
+
+/**
+ * @brief Get the number of OUT packets started by usbSerialJtag_read
+ *
+ * @return uint32_t Free-running packet counter (wraps at 2^32)
+ */
+uint32_t usbSerialJtag_rxPacketCount(void);
+
+/**
+ * @brief Forget the OUT packet in progress, after its bytes were dropped by a FIFO reset
+ */
+void usbSerialJtag_rxReset(void);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_CDC_H
\ No newline at end of file
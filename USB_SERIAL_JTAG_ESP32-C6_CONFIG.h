@@ -0,0 +1,210 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_CONFIG.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Compile-time configuration of the ESP32-C6 USB Serial JTAG driver
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file defines the default value of every compile-time option of the driver. Each
+ * option can be overridden from the compiler command line (-DUSB_SERIAL_JTAG_CFG_xxx=value) or by
+ * defining it before this file is included.
+ *
+ * The naming notation is as follows:
+ *
+ * CONFIGURATION OPTION             ==>   USB_SERIAL_JTAG_CFG_ + OPTIONname
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_CONFIG_H
+#define USB_SERIAL_JTAG_ESP32_C6_CONFIG_H
+
+/********************************************************************************************************************************
+*********************************************************** Register Access *****************************************************
+*********************************************************************************************************************************/
+
+#define kUSB_SERIAL_JTAG_CHIP_ESP32C6 0U // Values of USB_SERIAL_JTAG_CFG_CHIP
+#define kUSB_SERIAL_JTAG_CHIP_ESP32H2 1U
+#define kUSB_SERIAL_JTAG_CHIP_ESP32C3 2U
+#define kUSB_SERIAL_JTAG_CHIP_ESP32S3 3U
+
+#ifndef USB_SERIAL_JTAG_CFG_CHIP
+#define USB_SERIAL_JTAG_CFG_CHIP kUSB_SERIAL_JTAG_CHIP_ESP32C6 // Chip of the register map, selects the base address and the register blocks (kUSB_SERIAL_JTAG_HAS_*)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_BASE_ADDR
+#if USB_SERIAL_JTAG_CFG_CHIP == kUSB_SERIAL_JTAG_CHIP_ESP32C3
+#define USB_SERIAL_JTAG_CFG_BASE_ADDR 0x60043000UL // Base address of the controller registers (usbSerialJtag_hw)
+#elif USB_SERIAL_JTAG_CFG_CHIP == kUSB_SERIAL_JTAG_CHIP_ESP32S3
+#define USB_SERIAL_JTAG_CFG_BASE_ADDR 0x60038000UL // Base address of the controller registers (usbSerialJtag_hw)
+#else
+#define USB_SERIAL_JTAG_CFG_BASE_ADDR 0x6000F000UL // Base address of the controller registers (usbSerialJtag_hw)
+#endif
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_SIM_ENABLE
+#define USB_SERIAL_JTAG_CFG_SIM_ENABLE 0 // 1 to run the driver on the host register model (sim/usb_serial_jtag_sim.h), host builds only
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_ATOMIC_AMO
+#define USB_SERIAL_JTAG_CFG_ATOMIC_AMO 0 // 1 to implement set/clr/xor with amoor.w/amoand.w/amoxor.w (the peripheral bus must accept AMOs), 0 to mask MIE around a read-modify-write
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_CPU_FREQ_HZ
+#define USB_SERIAL_JTAG_CFG_CPU_FREQ_HZ 160000000UL // CPU clock in Hz, time base of the cycle counter (USB_SERIAL_JTAG_ESP32-C6_PORT.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+#define USB_SERIAL_JTAG_CFG_TRACE_ENABLE 0 // 1 to count every register access (profiling build, USB_SERIAL_JTAG_ESP32-C6_TRACE.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_TRACE_DEPTH
+#define USB_SERIAL_JTAG_CFG_TRACE_DEPTH 256U // Entries of the RAM trace buffer (power of two), 0 to only count the accesses
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_TRACE_SITES
+#define USB_SERIAL_JTAG_CFG_TRACE_SITES 32U // Functions tracked for the r/b macro accesses (power of two)
+#endif
+
+/********************************************************************************************************************************
+*********************************************************** Interrupt Driver ****************************************************
+*********************************************************************************************************************************/
+
+#ifndef USB_SERIAL_JTAG_CFG_TX_RING_SIZE
+#define USB_SERIAL_JTAG_CFG_TX_RING_SIZE 512U // Size in bytes of the interrupt driver TX ring (power of two)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_RX_RING_SIZE
+#define USB_SERIAL_JTAG_CFG_RX_RING_SIZE 512U // Size in bytes of the interrupt driver RX ring (power of two)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_TX_HOST_IDLE_MS
+#define USB_SERIAL_JTAG_CFG_TX_HOST_IDLE_MS 50U // ms without IN token on EP1, with TX data pending, before the host is considered absent
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+#define USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE 0 // 1 to mask SERIAL_OUT_RECV_PKT_INT after a received packet and drain the burst on SOF_INT
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_RX_MOD_PACKETS
+#define USB_SERIAL_JTAG_CFG_RX_MOD_PACKETS 8U // Default max packets of a moderation round (0 to disable at startup)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_RX_MOD_US
+#define USB_SERIAL_JTAG_CFG_RX_MOD_US 200U // Default max length in microseconds of a moderation round (checked on SOF_INT)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+#define USB_SERIAL_JTAG_CFG_TXQ_ENABLE 0 // 1 to service the scatter/gather TX descriptor queue from the ISR
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_TXQ_DEPTH
+#define USB_SERIAL_JTAG_CFG_TXQ_DEPTH 16U // Number of descriptors of the TX descriptor queue (power of two)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_POOL_BUFS
+#define USB_SERIAL_JTAG_CFG_POOL_BUFS 16U // Number of 64-byte buffers of the packet pool (USB_SERIAL_JTAG_ESP32-C6_POOL.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_ASYNC_ENABLE
+#define USB_SERIAL_JTAG_CFG_ASYNC_ENABLE 0 // 1 to complete the async read/write operations from the ISR (needs USB_SERIAL_JTAG_CFG_TXQ_ENABLE)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_OTA_ENABLE
+#define USB_SERIAL_JTAG_CFG_OTA_ENABLE 0 // 1 to drain the OUT packets into the flash page buffers while an update runs (USB_SERIAL_JTAG_ESP32-C6_OTA.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE
+#define USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE 4096U // Bytes of a flash page buffer (erase unit of the flash), two are allocated
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_MUX_ENABLE
+#define USB_SERIAL_JTAG_CFG_MUX_ENABLE 0 // 1 to schedule the cells of the virtual channels from the ISR (USB_SERIAL_JTAG_ESP32-C6_MUX.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_MUX_CHANNELS
+#define USB_SERIAL_JTAG_CFG_MUX_CHANNELS 4U // Number of virtual channels (power of two, up to 16)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_MUX_DEPTH
+#define USB_SERIAL_JTAG_CFG_MUX_DEPTH 8U // Messages queued per virtual channel (power of two)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_MUX_CRC
+#define USB_SERIAL_JTAG_CFG_MUX_CRC 1 // 1 to end every cell with a CRC-16 (59 message bytes per cell instead of 61)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_LOG_ENABLE
+#define USB_SERIAL_JTAG_CFG_LOG_ENABLE 0 // 1 to service the multi-producer log ring from the ISR
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_LOG_RING_SIZE
+#define USB_SERIAL_JTAG_CFG_LOG_RING_SIZE 1024U // Size in bytes of the log ring (power of two)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_BLOG_MAX_ARGS
+#define USB_SERIAL_JTAG_CFG_BLOG_MAX_ARGS 8U // Max argument words of a binary log record (up to 15)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_STATS_ENABLE
+#define USB_SERIAL_JTAG_CFG_STATS_ENABLE 0 // 1 to accumulate the runtime statistics and error counters from the ISR
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_LAT_ENABLE
+#define USB_SERIAL_JTAG_CFG_LAT_ENABLE 0 // 1 to record the ISR, RX drain and TX commit latency histograms (USB_SERIAL_JTAG_ESP32-C6_LAT.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_LAT_SUB_BITS
+#define USB_SERIAL_JTAG_CFG_LAT_SUB_BITS 2U // Histogram buckets per power of two, as a power of two (1 to 4)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+#define USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE 0 // 1 to coalesce short TX packets and commit them on SOF_INT or when they are full
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_SOF_FLUSH_FRAMES
+#define USB_SERIAL_JTAG_CFG_SOF_FLUSH_FRAMES 1U // Max SOF frames a short TX packet is kept open before it is committed (>= 1)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_JTAG_ENABLE
+#define USB_SERIAL_JTAG_CFG_JTAG_ENABLE 0 // 1 to count JTAG_IN_FLUSH_INT and call the JTAG flush callback from the ISR
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_LINE_ENABLE
+#define USB_SERIAL_JTAG_CFG_LINE_ENABLE 0 // 1 to serve the DTR/RTS and line coding events and call the line state callback from the ISR
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_LINE_TX_PAUSE
+#define USB_SERIAL_JTAG_CFG_LINE_TX_PAUSE 1 // 1 to hold the TX data back while DTR is low (needs USB_SERIAL_JTAG_CFG_LINE_ENABLE)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+#define USB_SERIAL_JTAG_CFG_RECOVER_ENABLE 0 // 1 to reset the FIFOs and flush the rings on USB_BUS_RESET_INT (USB_SERIAL_JTAG_ESP32-C6_RECOVER.h)
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_RECOVER_RETRIES
+#define USB_SERIAL_JTAG_CFG_RECOVER_RETRIES 3U // Reset pulses repeated when the async FIFO flags are not clean before the recovery is given up
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE
+#define USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE 0 // 1 to turn every zero length OUT packet into a frame delimiter in the RX ring
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_FRAME_RESYNC_BYTE
+#define USB_SERIAL_JTAG_CFG_FRAME_RESYNC_BYTE 0x00U // Delimiter queued on a zero length OUT packet (0x00 COBS, 0xC0 SLIP)
+#endif
+
+/********************************************************************************************************************************
+*********************************************************** Power Management ****************************************************
+*********************************************************************************************************************************/
+
+#ifndef USB_SERIAL_JTAG_CFG_PM_SUSPEND_FRAMES
+#define USB_SERIAL_JTAG_CFG_PM_SUSPEND_FRAMES 3U // Frames (ms) without SOF before the bus is considered suspended
+#endif
+
+#ifndef USB_SERIAL_JTAG_CFG_PM_MEM_PD
+#define USB_SERIAL_JTAG_CFG_PM_MEM_PD 0 // 1 to also power down the USB memory while suspended (the FIFO contents are lost)
+#endif
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_CONFIG_H
\ No newline at end of file
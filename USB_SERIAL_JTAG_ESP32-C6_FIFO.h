@@ -0,0 +1,167 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_FIFO.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Copy kernels between RAM and the EP1 FIFO of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file defines the inner loops of the data path: the EP1 register moves one byte
+ * per access, the kernels move the RAM side one 32-bit word at a time (one load, four byte stores
+ * to the FIFO, or four byte loads and one store) and unroll the loop, with no status check in
+ * between. The caller bounds the length by the free space (IN) or the received count (OUT).
+ * Every kernel takes the register block whose FIFO it moves (usbSerialJtag_hwEp1Push/Pop).
+ *
+ * usbSerialJtag_fifoPush and usbSerialJtag_fifoPull take any buffer: the bytes up to a word
+ * boundary are moved one by one, then 16 bytes per iteration. The fixed size variants
+ * (8, 16, 32, 64 bytes) take a 4-byte aligned buffer and are fully unrolled at compile time, a
+ * 64-byte variant fills a whole packet:
+ *
+ *     uint8_t *pkt = usbSerialJtag_poolAlloc();   // 64-byte aligned
+ *     ...
+ *     usbSerialJtag_fifoPush64(hw, pkt);
+ *     usbSerialJtag_txFlush(hw);
+ *
+ * The RAM words are little endian, as the RISC-V core of the ESP32-C6.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_FIFO_H
+#define USB_SERIAL_JTAG_ESP32_C6_FIFO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+_Static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "FIFO copy kernels expect little endian words");
+
+
+/**
+ * @brief Push the four bytes of a word, lowest address first
+ */
+static inline void usbSerialJtag_fifoPushWord(__usbSerialJtag_t *hw, uint32_t word)
+{
+    usbSerialJtag_hwEp1Push(hw, word & 0xFFU);
+    usbSerialJtag_hwEp1Push(hw, (word >> 8) & 0xFFU);
+    usbSerialJtag_hwEp1Push(hw, (word >> 16) & 0xFFU);
+    usbSerialJtag_hwEp1Push(hw, word >> 24);
+}
+
+/**
+ * @brief Pull four bytes into a word, the first byte in the lowest address
+ */
+static inline uint32_t usbSerialJtag_fifoPullWord(__usbSerialJtag_t *hw)
+{
+    uint32_t word = usbSerialJtag_hwEp1Pop(hw) & 0xFFU;
+    word |= (usbSerialJtag_hwEp1Pop(hw) & 0xFFU) << 8;
+    word |= (usbSerialJtag_hwEp1Pop(hw) & 0xFFU) << 16;
+    word |= (usbSerialJtag_hwEp1Pop(hw) & 0xFFU) << 24;
+    return word;
+}
+
+// Aligned 32-bit load and store of the RAM side (one lw/sw, no aliasing issue)
+static inline uint32_t __usbSerialJtag_fifoLoad(const uint8_t *p)
+{
+    uint32_t word;
+    __builtin_memcpy(&word, __builtin_assume_aligned(p, 4), 4);
+    return word;
+}
+
+static inline void __usbSerialJtag_fifoStore(uint8_t *p, uint32_t word)
+{
+    __builtin_memcpy(__builtin_assume_aligned(p, 4), &word, 4);
+}
+
+// Constant length bodies of the fixed size variants, the loops are unrolled
+static inline void __usbSerialJtag_fifoPushWords(__usbSerialJtag_t *hw, const uint8_t *buf, uint32_t words)
+{
+    _Pragma("GCC unroll 16")
+    for (uint32_t i = 0; i < words; i++) {
+        usbSerialJtag_fifoPushWord(hw, __usbSerialJtag_fifoLoad(&buf[i * 4U]));
+    }
+}
+
+static inline void __usbSerialJtag_fifoPullWords(__usbSerialJtag_t *hw, uint8_t *buf, uint32_t words)
+{
+    _Pragma("GCC unroll 16")
+    for (uint32_t i = 0; i < words; i++) {
+        __usbSerialJtag_fifoStore(&buf[i * 4U], usbSerialJtag_fifoPullWord(hw));
+    }
+}
+
+
+/**
+ * @brief Push len bytes to the EP1 FIFO without status checks and without committing the packet
+ *
+ * @param hw Register block
+ * @param buf Pointer to the data (any alignment)
+ * @param len Number of bytes, up to the free space of the FIFO
+ */
+static inline void usbSerialJtag_fifoPush(__usbSerialJtag_t *hw, const uint8_t *buf, uint32_t len)
+{
+    while (len != 0 && ((uintptr_t) buf & 3U) != 0) {
+        usbSerialJtag_hwEp1Push(hw, *buf++);
+        len--;
+    }
+    for (; len >= 16U; len -= 16U, buf += 16) {
+        usbSerialJtag_fifoPushWord(hw, __usbSerialJtag_fifoLoad(&buf[0]));
+        usbSerialJtag_fifoPushWord(hw, __usbSerialJtag_fifoLoad(&buf[4]));
+        usbSerialJtag_fifoPushWord(hw, __usbSerialJtag_fifoLoad(&buf[8]));
+        usbSerialJtag_fifoPushWord(hw, __usbSerialJtag_fifoLoad(&buf[12]));
+    }
+    for (; len >= 4U; len -= 4U, buf += 4) {
+        usbSerialJtag_fifoPushWord(hw, __usbSerialJtag_fifoLoad(buf));
+    }
+    while (len != 0) {
+        usbSerialJtag_hwEp1Push(hw, *buf++);
+        len--;
+    }
+}
+
+/**
+ * @brief Pull len bytes from the EP1 FIFO without status checks
+ *
+ * @param hw Register block
+ * @param buf Pointer to the buffer where the data is stored (any alignment)
+ * @param len Number of bytes, up to the bytes left of the received packet
+ */
+static inline void usbSerialJtag_fifoPull(__usbSerialJtag_t *hw, uint8_t *buf, uint32_t len)
+{
+    while (len != 0 && ((uintptr_t) buf & 3U) != 0) {
+        *buf++ = (uint8_t) usbSerialJtag_hwEp1Pop(hw);
+        len--;
+    }
+    for (; len >= 16U; len -= 16U, buf += 16) {
+        __usbSerialJtag_fifoStore(&buf[0], usbSerialJtag_fifoPullWord(hw));
+        __usbSerialJtag_fifoStore(&buf[4], usbSerialJtag_fifoPullWord(hw));
+        __usbSerialJtag_fifoStore(&buf[8], usbSerialJtag_fifoPullWord(hw));
+        __usbSerialJtag_fifoStore(&buf[12], usbSerialJtag_fifoPullWord(hw));
+    }
+    for (; len >= 4U; len -= 4U, buf += 4) {
+        __usbSerialJtag_fifoStore(buf, usbSerialJtag_fifoPullWord(hw));
+    }
+    while (len != 0) {
+        *buf++ = (uint8_t) usbSerialJtag_hwEp1Pop(hw);
+        len--;
+    }
+}
+
+/**
+ * @brief Push 8, 16, 32 or 64 bytes of a 4-byte aligned buffer (fully unrolled)
+ */
+static inline void usbSerialJtag_fifoPush8(__usbSerialJtag_t *hw, const uint8_t *buf) { __usbSerialJtag_fifoPushWords(hw, buf, 2U); }
+static inline void usbSerialJtag_fifoPush16(__usbSerialJtag_t *hw, const uint8_t *buf) { __usbSerialJtag_fifoPushWords(hw, buf, 4U); }
+static inline void usbSerialJtag_fifoPush32(__usbSerialJtag_t *hw, const uint8_t *buf) { __usbSerialJtag_fifoPushWords(hw, buf, 8U); }
+static inline void usbSerialJtag_fifoPush64(__usbSerialJtag_t *hw, const uint8_t *buf) { __usbSerialJtag_fifoPushWords(hw, buf, 16U); }
+
+/**
+ * @brief Pull 8, 16, 32 or 64 bytes into a 4-byte aligned buffer (fully unrolled)
+ */
+static inline void usbSerialJtag_fifoPull8(__usbSerialJtag_t *hw, uint8_t *buf) { __usbSerialJtag_fifoPullWords(hw, buf, 2U); }
+static inline void usbSerialJtag_fifoPull16(__usbSerialJtag_t *hw, uint8_t *buf) { __usbSerialJtag_fifoPullWords(hw, buf, 4U); }
+static inline void usbSerialJtag_fifoPull32(__usbSerialJtag_t *hw, uint8_t *buf) { __usbSerialJtag_fifoPullWords(hw, buf, 8U); }
+static inline void usbSerialJtag_fifoPull64(__usbSerialJtag_t *hw, uint8_t *buf) { __usbSerialJtag_fifoPullWords(hw, buf, 16U); }
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_FIFO_H
\ No newline at end of file
@@ -0,0 +1,281 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_FRAME.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief COBS/SLIP binary framing for the CDC-ACM channel of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_FRAME.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+
+#define kCOBS_MAX_BLOCK 254U // Max data bytes of a COBS block (code 0xFF)
+
+// Encoder steps
+#define kENC_LEAD 0U // SLIP: leading END
+#define kENC_CODE 1U // COBS: code byte of the next block
+#define kENC_DATA 2U // Source bytes
+#define kENC_DELIM 3U // Trailing delimiter
+#define kENC_DONE 4U
+
+static const uint16_t crcNibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+
+static inline uint16_t crcByte(uint16_t crc, uint8_t byte)
+{
+    crc = (uint16_t) ((crc << 4) ^ crcNibble[(crc >> 12) ^ (byte >> 4)]);
+    crc = (uint16_t) ((crc << 4) ^ crcNibble[(crc >> 12) ^ (byte & 0x0FU)]);
+    return crc;
+}
+
+/**
+ * @brief Get byte i of the frame source (payload then CRC), the CRC is accumulated up to it
+ */
+static inline uint8_t encByte(__usbSerialJtag_frameEnc_t *enc, uint32_t i)
+{
+    if ((enc->flags & mUSB_SERIAL_JTAG_FRAME_CRC16) == 0) {
+        return enc->src[i];
+    }
+    while (enc->scan <= i && enc->scan < enc->len) {
+        enc->crc = crcByte(enc->crc, enc->src[enc->scan]);
+        enc->scan++;
+    }
+    if (i < enc->len) {
+        return enc->src[i];
+    }
+    return (i == enc->len) ? (uint8_t) (enc->crc >> 8) : (uint8_t) enc->crc;
+}
+
+static inline void encEmit(__usbSerialJtag_t *hw, uint8_t byte)
+{
+    usbSerialJtag_hwEp1Push(hw, byte);
+}
+
+static uint32_t encCobs(__usbSerialJtag_t *hw, __usbSerialJtag_frameEnc_t *enc, uint32_t space)
+{
+    uint32_t pushed = 0;
+
+    while (pushed < space && enc->state != kENC_DONE) {
+        if (enc->state == kENC_CODE) {
+            // Look ahead in the source for the end of the block
+            uint32_t n = 0;
+            while (n < kCOBS_MAX_BLOCK && enc->pos + n < enc->total && encByte(enc, enc->pos + n) != 0) {
+                n++;
+            }
+            enc->blockLeft = n;
+            enc->blockZero = (enc->pos + n < enc->total && n < kCOBS_MAX_BLOCK) ? 1U : 0U;
+            encEmit(hw, (uint8_t) (n + 1U));
+            pushed++;
+            enc->state = kENC_DATA;
+        } else if (enc->state == kENC_DATA) {
+            while (pushed < space && enc->blockLeft != 0) {
+                encEmit(hw, encByte(enc, enc->pos));
+                enc->pos++;
+                enc->blockLeft--;
+                pushed++;
+            }
+            if (enc->blockLeft == 0) {
+                if (enc->blockZero) {
+                    enc->pos++; // The zero is implied by the code of the block
+                    enc->state = kENC_CODE;
+                } else {
+                    enc->state = (uint8_t) ((enc->pos == enc->total) ? kENC_DELIM : kENC_CODE);
+                }
+            }
+        } else {
+            encEmit(hw, kUSB_SERIAL_JTAG_FRAME_COBS_DELIM);
+            pushed++;
+            enc->state = kENC_DONE;
+        }
+    }
+
+    return pushed;
+}
+
+static uint32_t encSlip(__usbSerialJtag_t *hw, __usbSerialJtag_frameEnc_t *enc, uint32_t space)
+{
+    uint32_t pushed = 0;
+
+    while (pushed < space && enc->state != kENC_DONE) {
+        if (enc->state == kENC_DATA) {
+            if (enc->pending != 0) {
+                encEmit(hw, enc->pending);
+                enc->pending = 0;
+            } else if (enc->pos == enc->total) {
+                enc->state = kENC_DELIM;
+                continue;
+            } else {
+                uint8_t byte = encByte(enc, enc->pos++);
+                if (byte == kUSB_SERIAL_JTAG_FRAME_SLIP_END) {
+                    encEmit(hw, kUSB_SERIAL_JTAG_FRAME_SLIP_ESC);
+                    enc->pending = kUSB_SERIAL_JTAG_FRAME_SLIP_ESC_END;
+                } else if (byte == kUSB_SERIAL_JTAG_FRAME_SLIP_ESC) {
+                    encEmit(hw, kUSB_SERIAL_JTAG_FRAME_SLIP_ESC);
+                    enc->pending = kUSB_SERIAL_JTAG_FRAME_SLIP_ESC_ESC;
+                } else {
+                    encEmit(hw, byte);
+                }
+            }
+        } else {
+            // Leading END flushes the line noise, trailing END closes the frame
+            encEmit(hw, kUSB_SERIAL_JTAG_FRAME_SLIP_END);
+            enc->state = (uint8_t) ((enc->state == kENC_LEAD) ? kENC_DATA : kENC_DONE);
+        }
+        pushed++;
+    }
+
+    return pushed;
+}
+
+/**
+ * @brief Close the current frame of the decoder
+ */
+static int decEnd(__usbSerialJtag_frameDec_t *dec, uint32_t truncated)
+{
+    uint32_t len = dec->len;
+    uint32_t error = dec->error | truncated;
+    uint32_t empty = (len == 0 && dec->code == 0 && !error) ? 1U : 0U;
+
+    dec->len = 0;
+    dec->code = 0;
+    dec->left = 0;
+    dec->esc = 0;
+    dec->error = 0;
+
+    if (empty) {
+        return kUSB_SERIAL_JTAG_FRAME_MORE;
+    }
+    if (error) {
+        return kUSB_SERIAL_JTAG_FRAME_ERROR;
+    }
+    if (dec->flags & mUSB_SERIAL_JTAG_FRAME_CRC16) {
+        if (len < 2U) {
+            return kUSB_SERIAL_JTAG_FRAME_ERROR;
+        }
+        len -= 2U;
+        uint16_t crc = usbSerialJtag_frameCrc16(0xFFFFU, dec->buf, len);
+        if (dec->buf[len] != (uint8_t) (crc >> 8) || dec->buf[len + 1U] != (uint8_t) crc) {
+            return kUSB_SERIAL_JTAG_FRAME_ERROR;
+        }
+    }
+    return (len != 0) ? (int) len : kUSB_SERIAL_JTAG_FRAME_MORE;
+}
+
+static inline void decAppend(__usbSerialJtag_frameDec_t *dec, uint8_t byte)
+{
+    if (dec->len >= dec->size) {
+        dec->error = 1;
+        return;
+    }
+    dec->buf[dec->len++] = byte;
+}
+
+
+uint16_t usbSerialJtag_frameCrc16(uint16_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc = crcByte(crc, data[i]);
+    }
+    return crc;
+}
+
+void usbSerialJtag_frameBegin(__usbSerialJtag_frameEnc_t *enc, uint32_t mode, uint32_t flags, const uint8_t *buf, size_t len)
+{
+    enc->src = buf;
+    enc->len = (uint32_t) len;
+    enc->total = (uint32_t) len + ((flags & mUSB_SERIAL_JTAG_FRAME_CRC16) ? 2U : 0U);
+    enc->pos = 0;
+    enc->scan = 0;
+    enc->blockLeft = 0;
+    enc->crc = 0xFFFFU;
+    enc->mode = (uint8_t) mode;
+    enc->flags = (uint8_t) flags;
+    enc->state = (uint8_t) ((mode == kUSB_SERIAL_JTAG_FRAME_SLIP) ? kENC_LEAD : kENC_CODE);
+    enc->blockZero = 0;
+    enc->pending = 0;
+}
+
+uint32_t usbSerialJtag_frameEncode(__usbSerialJtag_t *hw, __usbSerialJtag_frameEnc_t *enc, uint32_t space)
+{
+    if (enc->mode == kUSB_SERIAL_JTAG_FRAME_SLIP) {
+        return encSlip(hw, enc, space);
+    }
+    return encCobs(hw, enc, space);
+}
+
+uint32_t usbSerialJtag_frameDone(const __usbSerialJtag_frameEnc_t *enc)
+{
+    return (enc->state == kENC_DONE) ? 1U : 0U;
+}
+
+uint32_t usbSerialJtag_frameWrite(__usbSerialJtag_t *hw, __usbSerialJtag_frameEnc_t *enc)
+{
+    while (!usbSerialJtag_frameDone(enc)) {
+        uint32_t space = usbSerialJtag_txFree(hw);
+        if (space == 0) {
+            return 0;
+        }
+        usbSerialJtag_frameEncode(hw, enc, space);
+        usbSerialJtag_txFlush(hw);
+    }
+    return 1;
+}
+
+void usbSerialJtag_frameDecInit(__usbSerialJtag_frameDec_t *dec, uint32_t mode, uint32_t flags, uint8_t *buf, size_t size)
+{
+    dec->buf = buf;
+    dec->size = (uint32_t) size;
+    dec->len = 0;
+    dec->mode = (uint8_t) mode;
+    dec->flags = (uint8_t) flags;
+    dec->code = 0;
+    dec->left = 0;
+    dec->esc = 0;
+    dec->error = 0;
+}
+
+int usbSerialJtag_frameDecPut(__usbSerialJtag_frameDec_t *dec, uint8_t byte)
+{
+    if (dec->mode == kUSB_SERIAL_JTAG_FRAME_SLIP) {
+        if (byte == kUSB_SERIAL_JTAG_FRAME_SLIP_END) {
+            return decEnd(dec, dec->esc);
+        }
+        if (dec->esc) {
+            dec->esc = 0;
+            if (byte == kUSB_SERIAL_JTAG_FRAME_SLIP_ESC_END) {
+                byte = kUSB_SERIAL_JTAG_FRAME_SLIP_END;
+            } else if (byte == kUSB_SERIAL_JTAG_FRAME_SLIP_ESC_ESC) {
+                byte = kUSB_SERIAL_JTAG_FRAME_SLIP_ESC;
+            } else {
+                dec->error = 1;
+            }
+        } else if (byte == kUSB_SERIAL_JTAG_FRAME_SLIP_ESC) {
+            dec->esc = 1;
+            return kUSB_SERIAL_JTAG_FRAME_MORE;
+        }
+        decAppend(dec, byte);
+        return kUSB_SERIAL_JTAG_FRAME_MORE;
+    }
+
+    if (byte == kUSB_SERIAL_JTAG_FRAME_COBS_DELIM) {
+        return decEnd(dec, dec->left != 0);
+    }
+    if (dec->left == 0) {
+        // Code byte: the zero of the previous block is only known once another block follows
+        if (dec->code != 0 && dec->code != 0xFFU) {
+            decAppend(dec, 0);
+        }
+        dec->code = byte;
+        dec->left = (uint8_t) (byte - 1U);
+    } else {
+        decAppend(dec, byte);
+        dec->left--;
+    }
+    return kUSB_SERIAL_JTAG_FRAME_MORE;
+}
\ No newline at end of file
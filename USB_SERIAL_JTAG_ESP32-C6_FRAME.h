@@ -0,0 +1,163 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_FRAME.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief COBS/SLIP binary framing for the CDC-ACM channel of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the binary framing layer of the CDC-ACM channel. The encoder streams
+ * a frame straight from the application buffer into the EP1 FIFO, there is no encoded copy of the
+ * frame: COBS looks ahead in the source for the next zero, SLIP escapes byte by byte. The state is
+ * kept in __usbSerialJtag_frameEnc_t, so the encoding resumes where it stopped when the FIFO is
+ * full.
+ *
+ * The optional CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) is accumulated during the same pass
+ * over the source and sent big endian after the payload, inside the frame.
+ *
+ * The decoder takes the received bytes one by one and rebuilds the frames in the buffer of the
+ * application. With USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE the interrupt driver turns every zero
+ * length OUT packet (OUT_EP1_ZERO_PAYLOAD_INT) into a frame delimiter in the RX ring, so a host can
+ * force the decoder back to a frame boundary.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_FRAME_H
+#define USB_SERIAL_JTAG_ESP32_C6_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Framing modes
+ */
+#define kUSB_SERIAL_JTAG_FRAME_COBS 0U // Consistent Overhead Byte Stuffing, frames end with 0x00
+#define kUSB_SERIAL_JTAG_FRAME_SLIP 1U // RFC 1055, frames start and end with 0xC0
+
+/**
+ * Framing flags
+ */
+#define mUSB_SERIAL_JTAG_FRAME_CRC16 0x01U // Append (encoder) or check and strip (decoder) a CRC-16
+
+/**
+ * Frame delimiters
+ */
+#define kUSB_SERIAL_JTAG_FRAME_COBS_DELIM 0x00U
+#define kUSB_SERIAL_JTAG_FRAME_SLIP_END 0xC0U
+#define kUSB_SERIAL_JTAG_FRAME_SLIP_ESC 0xDBU
+#define kUSB_SERIAL_JTAG_FRAME_SLIP_ESC_END 0xDCU
+#define kUSB_SERIAL_JTAG_FRAME_SLIP_ESC_ESC 0xDDU
+
+/**
+ * Decoder results
+ */
+#define kUSB_SERIAL_JTAG_FRAME_MORE 0 // Frame not complete yet
+#define kUSB_SERIAL_JTAG_FRAME_ERROR (-1) // Malformed frame, CRC mismatch or buffer overflow (the frame is dropped)
+
+/**
+ * \typedef __usbSerialJtag_frameEnc_t
+ * State of a frame being encoded
+ */
+typedef struct {
+    const uint8_t *src; // Payload
+    uint32_t len; // Payload length
+    uint32_t total; // Payload length plus the CRC bytes
+    uint32_t pos; // Next source byte to be encoded
+    uint32_t scan; // Source bytes already accumulated in the CRC
+    uint32_t blockLeft; // COBS: source bytes left in the current block
+    uint16_t crc; // CRC of the bytes scanned
+    uint8_t mode; // kUSB_SERIAL_JTAG_FRAME_COBS or kUSB_SERIAL_JTAG_FRAME_SLIP
+    uint8_t flags; // mUSB_SERIAL_JTAG_FRAME_xxx
+    uint8_t state; // Encoder step
+    uint8_t blockZero; // COBS: the current block ends with a zero of the source
+    uint8_t pending; // SLIP: second byte of an escape sequence, 0 if none
+} __usbSerialJtag_frameEnc_t;
+
+/**
+ * \typedef __usbSerialJtag_frameDec_t
+ * State of the frame decoder
+ */
+typedef struct {
+    uint8_t *buf; // Storage of the frame
+    uint32_t size; // Size of the storage
+    uint32_t len; // Bytes decoded in the current frame
+    uint8_t mode; // kUSB_SERIAL_JTAG_FRAME_COBS or kUSB_SERIAL_JTAG_FRAME_SLIP
+    uint8_t flags; // mUSB_SERIAL_JTAG_FRAME_xxx
+    uint8_t code; // COBS: code of the current block
+    uint8_t left; // COBS: bytes left in the current block
+    uint8_t esc; // SLIP: escape received
+    uint8_t error; // Current frame is dropped up to the next delimiter
+} __usbSerialJtag_frameDec_t;
+
+
+/**
+ * @brief Compute a CRC-16/CCITT-FALSE
+ *
+ * @param crc Initial value (0xFFFF) or accumulated value
+ * @param data Pointer to the data
+ * @param len Number of bytes
+ * @return uint16_t Accumulated CRC
+ */
+uint16_t usbSerialJtag_frameCrc16(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Start the encoding of a frame, the buffer must stay valid until the frame is done
+ *
+ * @param enc Encoder state
+ * @param mode kUSB_SERIAL_JTAG_FRAME_COBS or kUSB_SERIAL_JTAG_FRAME_SLIP
+ * @param flags mUSB_SERIAL_JTAG_FRAME_xxx
+ * @param buf Payload of the frame
+ * @param len Payload length
+ */
+void usbSerialJtag_frameBegin(__usbSerialJtag_frameEnc_t *enc, uint32_t mode, uint32_t flags, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Push encoded bytes of the frame to the EP1 FIFO without committing the packet
+ *
+ * @param hw Register block
+ * @param enc Encoder state
+ * @param space Max number of bytes to be pushed (free space of the FIFO)
+ * @return uint32_t Number of bytes pushed
+ */
+uint32_t usbSerialJtag_frameEncode(__usbSerialJtag_t *hw, __usbSerialJtag_frameEnc_t *enc, uint32_t space);
+
+/**
+ * @brief Whether the whole frame, delimiter included, has been encoded
+ */
+uint32_t usbSerialJtag_frameDone(const __usbSerialJtag_frameEnc_t *enc);
+
+/**
+ * @brief Send the frame through the bulk EP1 path (non-blocking)
+ *
+ * @param hw Register block
+ * @param enc Encoder state
+ * @return uint32_t 1 when the frame is sent, 0 if the FIFO got full (call again)
+ */
+uint32_t usbSerialJtag_frameWrite(__usbSerialJtag_t *hw, __usbSerialJtag_frameEnc_t *enc);
+
+/**
+ * @brief Initialize a frame decoder
+ *
+ * @param dec Decoder state
+ * @param mode kUSB_SERIAL_JTAG_FRAME_COBS or kUSB_SERIAL_JTAG_FRAME_SLIP
+ * @param flags mUSB_SERIAL_JTAG_FRAME_xxx
+ * @param buf Storage of the decoded frame
+ * @param size Size of the storage (payload plus CRC)
+ */
+void usbSerialJtag_frameDecInit(__usbSerialJtag_frameDec_t *dec, uint32_t mode, uint32_t flags, uint8_t *buf, size_t size);
+
+/**
+ * @brief Feed one received byte to the decoder
+ *
+ * @param dec Decoder state
+ * @param byte Received byte
+ * @return int Payload length (> 0) when a frame is complete and valid, kUSB_SERIAL_JTAG_FRAME_MORE
+ *  or kUSB_SERIAL_JTAG_FRAME_ERROR
+ */
+int usbSerialJtag_frameDecPut(__usbSerialJtag_frameDec_t *dec, uint8_t byte);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_FRAME_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_IMAGE.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Configuration image of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_IMAGE.h"
+
+
+/**
+ * @brief Write one register of the image if its writable bits differ from the reference
+ *
+ * @return uint32_t 1 if the register was written
+ */
+static inline uint32_t imageStore(volatile uint32_t *reg, uint32_t value, uint32_t ref, uint32_t mask)
+{
+    if (((value ^ ref) & mask) == 0) {
+        return 0;
+    }
+    __usbSerialJtag_regWrite(reg, value & mask);
+    return 1;
+}
+
+/**
+ * @brief Write the image against a reference image, then commit it with one CONFIG_UPDATE
+ */
+static uint32_t imageApply(const __usbSerialJtag_image_t *img, const __usbSerialJtag_image_t *ref)
+{
+    __usbSerialJtag_t *hw = usbSerialJtag_hw();
+    uint32_t stores = 0;
+
+    // Clocks and memory first, the other registers are written through them
+    stores += imageStore(&hw->miscConfReg.WORD, img->miscConf, ref->miscConf, mUSB_SERIAL_JTAG_IMAGE_MISC_CONF);
+    stores += imageStore(&hw->memConfReg.WORD, img->memConf, ref->memConf, mUSB_SERIAL_JTAG_IMAGE_MEM_CONF);
+    stores += imageStore(&hw->conf0Reg.WORD, img->conf0, ref->conf0, mUSB_SERIAL_JTAG_IMAGE_CONF0);
+    stores += imageStore(&hw->testReg.WORD, img->test, ref->test, mUSB_SERIAL_JTAG_IMAGE_TEST);
+#if kUSB_SERIAL_JTAG_HAS_LINE_REGS
+    stores += imageStore(&hw->chipRstReg.WORD, img->chipRst, ref->chipRst, mUSB_SERIAL_JTAG_IMAGE_CHIP_RST);
+    stores += imageStore(&hw->getLineCodeW0Reg.WORD, img->getLineCodeW0, ref->getLineCodeW0, mUSB_SERIAL_JTAG_IMAGE_GET_LINE_CODE_W0);
+    stores += imageStore(&hw->getLineCodeW1Reg.WORD, img->getLineCodeW1, ref->getLineCodeW1, mUSB_SERIAL_JTAG_IMAGE_GET_LINE_CODE_W1);
+
+    // One domain crossing for the whole image
+    if (stores != 0) {
+        usbSerialJtag_hwRegWrite(hw, configUpdateReg, mUSBSERIALJTAG_CONFIGUPDATEREG_CONFIG_UPDATE);
+    }
+#endif
+
+    // Interrupts last, their handlers see the restored configuration
+    stores += imageStore(&hw->intEnaReg.WORD, img->intEna, ref->intEna, mUSB_SERIAL_JTAG_IMAGE_INT_ENA);
+
+    return stores;
+}
+
+
+void usbSerialJtag_imageReset(__usbSerialJtag_image_t *img)
+{
+    img->miscConf = mUSBSERIALJTAG_MISCCONFREG_RESET;
+    img->memConf = mUSBSERIALJTAG_MEMCONFREG_RESET;
+    img->conf0 = mUSBSERIALJTAG_CONF0REG_RESET;
+    img->test = mUSBSERIALJTAG_TESTREG_RESET & mUSB_SERIAL_JTAG_IMAGE_TEST;
+    img->chipRst = mUSBSERIALJTAG_CHIPRSTREG_RESET;
+    img->getLineCodeW0 = mUSBSERIALJTAG_GETLINECODEW0REG_RESET;
+    img->getLineCodeW1 = mUSBSERIALJTAG_GETLINECODEW1REG_RESET;
+    img->intEna = mUSBSERIALJTAG_INTSTATUSREG_RESET_ENA;
+}
+
+void usbSerialJtag_imageCapture(__usbSerialJtag_image_t *img)
+{
+    __usbSerialJtag_t *hw = usbSerialJtag_hw();
+
+    img->miscConf = usbSerialJtag_hwRegRead(hw, miscConfReg) & mUSB_SERIAL_JTAG_IMAGE_MISC_CONF;
+    img->memConf = usbSerialJtag_hwRegRead(hw, memConfReg) & mUSB_SERIAL_JTAG_IMAGE_MEM_CONF;
+    img->conf0 = usbSerialJtag_hwRegRead(hw, conf0Reg) & mUSB_SERIAL_JTAG_IMAGE_CONF0;
+    img->test = usbSerialJtag_hwRegRead(hw, testReg) & mUSB_SERIAL_JTAG_IMAGE_TEST;
+#if kUSB_SERIAL_JTAG_HAS_LINE_REGS
+    img->chipRst = usbSerialJtag_hwRegRead(hw, chipRstReg) & mUSB_SERIAL_JTAG_IMAGE_CHIP_RST;
+    img->getLineCodeW0 = usbSerialJtag_hwRegRead(hw, getLineCodeW0Reg) & mUSB_SERIAL_JTAG_IMAGE_GET_LINE_CODE_W0;
+    img->getLineCodeW1 = usbSerialJtag_hwRegRead(hw, getLineCodeW1Reg) & mUSB_SERIAL_JTAG_IMAGE_GET_LINE_CODE_W1;
+#else
+    img->chipRst = mUSBSERIALJTAG_CHIPRSTREG_RESET;
+    img->getLineCodeW0 = mUSBSERIALJTAG_GETLINECODEW0REG_RESET;
+    img->getLineCodeW1 = mUSBSERIALJTAG_GETLINECODEW1REG_RESET;
+#endif
+    img->intEna = usbSerialJtag_hwRegRead(hw, intEnaReg) & mUSB_SERIAL_JTAG_IMAGE_INT_ENA;
+}
+
+uint32_t usbSerialJtag_imageRestore(const __usbSerialJtag_image_t *img)
+{
+    __usbSerialJtag_image_t live;
+
+    usbSerialJtag_imageCapture(&live);
+    return imageApply(img, &live);
+}
+
+uint32_t usbSerialJtag_imageRestoreAfterReset(const __usbSerialJtag_image_t *img)
+{
+    __usbSerialJtag_image_t reset;
+
+    usbSerialJtag_imageReset(&reset);
+    return imageApply(img, &reset);
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_IMAGE.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Configuration image of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the configuration image: a copy of the writable state of
+ * __usbSerialJtag_t that is captured once and restored in a single pass after a reset or a power
+ * down, instead of reprogramming the registers field by field.
+ *
+ * The restore only stores the registers whose writable bits differ from the reference (the live
+ * registers or the reset values), in dependency order (clocks first, interrupt enables last), and
+ * issues a single CONFIG_UPDATE to move the values to the 48 MHz clock domain.
+ *
+ * The self-clearing controls (WR_DONE, INT_CLR, the JTAG and AFIFO FIFO resets) are not part of
+ * the image.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_IMAGE_H
+#define USB_SERIAL_JTAG_ESP32_C6_IMAGE_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Writable bits of the registers of the image
+ */
+#define mUSB_SERIAL_JTAG_IMAGE_CONF0 0x0000FFFFUL // conf0Reg: bits 0-15
+#define mUSB_SERIAL_JTAG_IMAGE_TEST 0x0000000FUL // testReg: TEST_ENABLE, TEST_USB_OE, TEST_TX_DP, TEST_TX_DM
+#define mUSB_SERIAL_JTAG_IMAGE_MISC_CONF mUSBSERIALJTAG_MISCCONFREG_CLK_EN // miscConfReg: CLK_EN
+#define mUSB_SERIAL_JTAG_IMAGE_MEM_CONF (mUSBSERIALJTAG_MEMCONFREG_USB_MEM_PD | mUSBSERIALJTAG_MEMCONFREG_USB_MEM_CLK_EN) // memConfReg
+#define mUSB_SERIAL_JTAG_IMAGE_CHIP_RST mUSBSERIALJTAG_CHIPRSTREG_USB_UART_CHIP_RST_DIS // chipRstReg: USB_UART_CHIP_RST_DIS
+#define mUSB_SERIAL_JTAG_IMAGE_GET_LINE_CODE_W0 0xFFFFFFFFUL // getLineCodeW0Reg: dwDTERate
+#define mUSB_SERIAL_JTAG_IMAGE_GET_LINE_CODE_W1 0x00FFFFFFUL // getLineCodeW1Reg: bDataBits, bParityType, bCharFormat
+#define mUSB_SERIAL_JTAG_IMAGE_INT_ENA 0x0000FFFFUL // intEnaReg: all the sources
+
+/**
+ * \typedef __usbSerialJtag_image_t
+ * Writable state of the controller
+ */
+typedef struct {
+    uint32_t miscConf; // miscConfReg
+    uint32_t memConf; // memConfReg
+    uint32_t conf0; // conf0Reg
+    uint32_t test; // testReg
+    uint32_t chipRst; // chipRstReg
+    uint32_t getLineCodeW0; // getLineCodeW0Reg
+    uint32_t getLineCodeW1; // getLineCodeW1Reg
+    uint32_t intEna; // intEnaReg
+} __usbSerialJtag_image_t;
+
+
+/**
+ * @brief Fill an image with the reset values of the registers
+ *
+ * @param img Image to be filled
+ */
+void usbSerialJtag_imageReset(__usbSerialJtag_image_t *img);
+
+/**
+ * @brief Capture the writable state of the controller
+ *
+ * @param img Image to be filled
+ */
+void usbSerialJtag_imageCapture(__usbSerialJtag_image_t *img);
+
+/**
+ * @brief Restore an image, only the registers that differ from the live registers are written
+ *
+ * @param img Image to be restored
+ * @return uint32_t Number of registers written (CONFIG_UPDATE excluded)
+ */
+uint32_t usbSerialJtag_imageRestore(const __usbSerialJtag_image_t *img);
+
+/**
+ * @brief Restore an image right after a reset of the controller, without reading the registers
+ *
+ * The registers are compared with their reset values, so only the ones changed by the application
+ * are written.
+ *
+ * @param img Image to be restored
+ * @return uint32_t Number of registers written (CONFIG_UPDATE excluded)
+ */
+uint32_t usbSerialJtag_imageRestoreAfterReset(const __usbSerialJtag_image_t *img);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_IMAGE_H
\ No newline at end of file
@@ -0,0 +1,859 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_ISR.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Interrupt driven CDC-ACM driver for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * Ownership of the INT_ENA bits: SERIAL_IN_EMPTY_INT and IN_TOKEN_REC_IN_EP1_INT are enabled by the
+ * producer and disabled by the ISR, SERIAL_OUT_RECV_PKT_INT is toggled by the consumer (the RX
+ * moderation masks it from the ISR, the consumer unmasks it at the end of the round) and SOF_INT
+ * is only toggled by the ISR. All the INT_ENA updates use the atomic set/clr macros, so no
+ * update is lost whatever context preempts the other.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_RING.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_STATS.h"
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_LAT.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_TXQ.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_ASYNC_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_ASYNC.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_LOG.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_MUX_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_MUX.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_OTA_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_OTA.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_JTAG_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_JTAG.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_LINE.h"
+#endif
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_RECOVER.h"
+#endif
+
+_Static_assert((USB_SERIAL_JTAG_CFG_TX_RING_SIZE & (USB_SERIAL_JTAG_CFG_TX_RING_SIZE - 1U)) == 0, "TX ring size must be a power of two");
+_Static_assert((USB_SERIAL_JTAG_CFG_RX_RING_SIZE & (USB_SERIAL_JTAG_CFG_RX_RING_SIZE - 1U)) == 0, "RX ring size must be a power of two");
+_Static_assert(USB_SERIAL_JTAG_CFG_SOF_FLUSH_FRAMES >= 1U, "SOF flush latency cap must be at least one frame");
+
+static uint8_t txStorage[USB_SERIAL_JTAG_CFG_TX_RING_SIZE];
+static uint8_t rxStorage[USB_SERIAL_JTAG_CFG_RX_RING_SIZE];
+static __usbSerialJtag_ring_t txRing;
+static __usbSerialJtag_ring_t rxRing;
+static volatile uint32_t rxStalled = 0; // Set by the ISR when the RX ring is full and data is left in the FIFO
+static uint32_t rxKick = 0; // Set by the consumer once it freed room in a stalled RX ring, cleared by the ISR
+static uint32_t txDropped = 0; // Bytes dropped by the backpressure policies (producer only)
+static uint32_t hostTokenCycles = 0; // Cycle count of the last IN token seen on EP1 (producer only)
+static uint32_t rxModPackets = USB_SERIAL_JTAG_CFG_RX_MOD_PACKETS; // Packet budget of a moderation round, 0 disabled
+static uint32_t rxModCycles = USB_SERIAL_JTAG_CFG_RX_MOD_US * kUSB_SERIAL_JTAG_CYCLES_PER_US; // Length limit of a round
+
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+static uint32_t rxPolling = 0; // Round open, SERIAL_OUT_RECV_PKT_INT masked (ISR only)
+static uint32_t rxPollPackets = 0; // Packets drained by the SOF_INT of the current round (ISR only)
+static uint32_t rxPollStart = 0; // Cycle count of the ISR entry that started the round (ISR only)
+#endif
+
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+static uint32_t txOpen = 0; // Bytes pushed to the FIFO and not committed yet (ISR only)
+static uint32_t txAge = 0; // SOF frames the open packet has waited (ISR only)
+#endif
+
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+static uint32_t rxFlushHead = 0; // RX ring head at the last bus reset, the consumer drops the bytes before it
+#endif
+
+// Interrupt sources served by the handler
+#define mISR_CDC (mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT)
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+#define mISR_SOF_FLUSH (mUSBSERIALJTAG_INTSTATUSREG_SOF_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT)
+#else
+#define mISR_SOF_FLUSH 0U
+#endif
+#if USB_SERIAL_JTAG_CFG_JTAG_ENABLE
+#define mISR_JTAG mUSBSERIALJTAG_INTSTATUSREG_IN_FLUSH_INT
+#else
+#define mISR_JTAG 0U
+#endif
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+#define mISR_LINE mUSB_SERIAL_JTAG_LINE_EVENTS
+#else
+#define mISR_LINE 0U
+#endif
+#if USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE
+#define mISR_RESYNC mUSBSERIALJTAG_INTSTATUSREG_OUT_EP1_ZERO_PAYLOAD_INT
+#else
+#define mISR_RESYNC 0U
+#endif
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+#define mISR_RECOVER (mUSBSERIALJTAG_INTSTATUSREG_USB_BUS_RESET_INT | mUSBSERIALJTAG_INTSTATUSREG_SOF_INT)
+#else
+#define mISR_RECOVER 0U
+#endif
+#define mISR_RX_SOF mUSBSERIALJTAG_INTSTATUSREG_SOF_INT // RX drains paced by the frames (moderation rounds, stalled ring)
+#define mISR_SOURCES (mISR_CDC | mISR_SOF_FLUSH | mISR_JTAG | mISR_LINE | mISR_RESYNC | mISR_RECOVER | mISR_RX_SOF)
+
+#define kHOST_IDLE_CYCLES ((uint32_t) (USB_SERIAL_JTAG_CFG_TX_HOST_IDLE_MS * kUSB_SERIAL_JTAG_CYCLES_PER_MS))
+
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+#define STATS_ADD(st, field, n) ((st)->field += (uint32_t) (n))
+#else
+#define STATS_ADD(st, field, n) ((void) (st))
+#endif
+
+
+/**
+ * @brief Move the received packets from the FIFO to the RX ring
+ *
+ * @param hw Register block
+ * @param st Counters of the caller
+ * @return uint32_t 1 if the ring got full before the FIFO was empty
+ */
+static uint32_t rxDrain(__usbSerialJtag_t *hw, __usbSerialJtag_stats_t *st)
+{
+    uint32_t packets = usbSerialJtag_rxPacketCount();
+    uint32_t full = 0;
+
+    for (;;) {
+        uint32_t room;
+        uint8_t *dst = usbSerialJtag_ringWritePtr(&rxRing, &room);
+        if (room == 0) {
+            full = (usbSerialJtag_hwRegRead(hw, ep1ConfReg) & mUSBSERIALJTAG_EP1CONFREG_SERIAL_OUT_EP_DATA_AVAIL) ? 1U : 0U;
+            break;
+        }
+        size_t got = usbSerialJtag_read(hw, dst, room);
+        if (got == 0) {
+            break;
+        }
+        usbSerialJtag_ringCommit(&rxRing, (uint32_t) got);
+        STATS_ADD(st, ep1OutBytes, got);
+    }
+
+    STATS_ADD(st, ep1OutPackets, usbSerialJtag_rxPacketCount() - packets);
+    STATS_ADD(st, rxRingFull, full);
+    (void) packets;
+    return full;
+}
+
+/**
+ * @brief Whether SOF_INT has to be served by the next frames
+ */
+static inline uint32_t sofWanted(void)
+{
+    if (__atomic_load_n(&rxKick, __ATOMIC_ACQUIRE)) {
+        return 1;
+    }
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+    if (rxPolling) {
+        return 1;
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    if (usbSerialJtag_recoverState() != kUSB_SERIAL_JTAG_RECOVER_IDLE) {
+        return 1;
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    return (txOpen != 0) ? 1U : 0U;
+#else
+    return 0;
+#endif
+}
+
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+/**
+ * @brief Start a moderation round after a received packet (ISR side)
+ *
+ * SERIAL_OUT_RECV_PKT_INT is masked, the next packets of the burst are drained by rxPollSof on
+ * the SOF_INT of the next frames (enabled by sofWanted).
+ *
+ * @param st Counters of the caller
+ */
+static void rxPollEnter(__usbSerialJtag_stats_t *st)
+{
+    if (__atomic_load_n(&rxModPackets, __ATOMIC_RELAXED) == 0) {
+        return;
+    }
+
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+    if (!sofWanted()) {
+        // The SOF_INT latched while the source was disabled is stale, the round waits for the next frame
+        setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_SOF_INT);
+    }
+    rxPollPackets = 0;
+    rxPollStart = usbSerialJtag_cycles();
+    rxPolling = 1;
+    STATS_ADD(st, rxModRounds, 1);
+}
+
+/**
+ * @brief End the moderation round and unmask SERIAL_OUT_RECV_PKT_INT (ISR side)
+ *
+ * @param hw Register block
+ * @param st Counters of the caller
+ * @param drain 0 to leave the FIFO to the next ISR entry (firmware update running)
+ */
+static void rxPollEnd(__usbSerialJtag_t *hw, __usbSerialJtag_stats_t *st, uint32_t drain)
+{
+    if (drain) {
+        // The packets drained in the round raised the RAW bit. A packet that arrived before the
+        // clear is still flagged by DATA_AVAIL, one that arrives after it raises the interrupt again
+        setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+        rxStalled = rxDrain(hw, st);
+    }
+    rxPolling = 0;
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+}
+
+/**
+ * @brief Drain the packet waiting in the OUT FIFO on the SOF_INT of an open round (ISR side)
+ *
+ * The round ends on the first frame that brings no packet, once it reached its packet budget or
+ * its time limit, or once the RX ring is full (the stalled ring path takes over).
+ *
+ * @param hw Register block
+ * @param st Counters of the caller
+ * @return uint32_t Number of packets drained
+ */
+static uint32_t rxPollSof(__usbSerialJtag_t *hw, __usbSerialJtag_stats_t *st)
+{
+    uint32_t first = usbSerialJtag_rxPacketCount();
+    uint32_t full = rxDrain(hw, st);
+    uint32_t drained = usbSerialJtag_rxPacketCount() - first;
+
+    rxPollPackets += drained;
+    STATS_ADD(st, rxModPolled, drained);
+
+    if (full || drained == 0 || rxPollPackets >= __atomic_load_n(&rxModPackets, __ATOMIC_RELAXED) ||
+        usbSerialJtag_cycles() - rxPollStart >= __atomic_load_n(&rxModCycles, __ATOMIC_RELAXED)) {
+        rxPollEnd(hw, st, 1);
+    }
+    return drained;
+}
+#endif
+
+/**
+ * @brief Push the pending TX data to the FIFO without committing the packet
+ *
+ * @param hw Register block
+ * @param space Free space of the FIFO
+ * @return uint32_t Number of bytes pushed
+ */
+static uint32_t txFillPacket(__usbSerialJtag_t *hw, uint32_t space)
+{
+    uint32_t pushed = 0;
+
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+    // A descriptor in progress is finished before the ring is served again
+    if (usbSerialJtag_txqBusy()) {
+        pushed = usbSerialJtag_txqFill(hw, space);
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+    // Likewise for a log record, only one source can be left in progress by the previous packet
+    if (usbSerialJtag_logBusy()) {
+        pushed += usbSerialJtag_logFill(hw, space - pushed);
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_MUX_ENABLE
+    if (usbSerialJtag_muxBusy()) {
+        pushed += usbSerialJtag_muxFill(hw, space - pushed);
+    }
+#endif
+
+    // A packet may span the wrap point of the ring, it is still committed once
+    while (pushed < space) {
+        uint32_t avail;
+        const uint8_t *src = usbSerialJtag_ringReadPtr(&txRing, &avail);
+        if (avail == 0) {
+            break;
+        }
+        if (avail > space - pushed) {
+            avail = space - pushed;
+        }
+        usbSerialJtag_txPush(hw, src, avail);
+        usbSerialJtag_ringConsume(&txRing, avail);
+        pushed += avail;
+    }
+
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+    if (pushed < space) {
+        pushed += usbSerialJtag_txqFill(hw, space - pushed);
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+    if (pushed < space) {
+        pushed += usbSerialJtag_logFill(hw, space - pushed);
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_MUX_ENABLE
+    if (pushed < space) {
+        pushed += usbSerialJtag_muxFill(hw, space - pushed);
+    }
+#endif
+
+    return pushed;
+}
+
+/**
+ * @brief Whether there is TX data left for the FIFO
+ */
+static uint32_t txPending(void)
+{
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+    if (usbSerialJtag_txqPending() != 0) {
+        return 1;
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+    if (usbSerialJtag_logPending()) {
+        return 1;
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_MUX_ENABLE
+    if (usbSerialJtag_muxPending()) {
+        return 1;
+    }
+#endif
+    return (usbSerialJtag_ringCount(&txRing) != 0) ? 1U : 0U;
+}
+
+/**
+ * @brief Whether the TX path is held back, the ISR is kicked again when it resumes
+ */
+static inline uint32_t txPaused(void)
+{
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    // The FIFOs are held in reset until the bus reset is released
+    if (usbSerialJtag_recoverState() != kUSB_SERIAL_JTAG_RECOVER_IDLE) {
+        return 1;
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+    return usbSerialJtag_lineTxPaused();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Commit the bytes pushed to the FIFO as one packet
+ *
+ * @param hw Register block
+ * @param st Counters of the caller
+ */
+static void txCommit(__usbSerialJtag_t *hw, __usbSerialJtag_stats_t *st)
+{
+    usbSerialJtag_txFlush(hw);
+    STATS_ADD(st, ep1InPackets, 1);
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+    usbSerialJtag_latTxCommitted();
+#endif
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    txOpen = 0;
+    txAge = 0;
+#endif
+}
+
+/**
+ * @brief Move the pending TX data to the FIFO, one WR_DONE per packet
+ *
+ * With the SOF flush scheduler a short packet is left open, it is committed by a later call once
+ * it is full or by the SOF_INT that reaches the latency cap.
+ *
+ * @param hw Register block
+ * @param st Counters of the caller
+ */
+static void txFill(__usbSerialJtag_t *hw, __usbSerialJtag_stats_t *st)
+{
+    // Nobody reads the port while DTR is low, the data stays in the ring
+    if (txPaused()) {
+        return;
+    }
+
+    // The free space already accounts for the bytes of an open packet (WR_ADDR)
+    uint32_t space = usbSerialJtag_txFree(hw);
+
+    while (space != 0) {
+        uint32_t pushed = txFillPacket(hw, space);
+        if (pushed == 0) {
+            break;
+        }
+        STATS_ADD(st, ep1InBytes, pushed);
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+        txOpen += pushed;
+        if (txOpen < kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE) {
+            break;
+        }
+#endif
+        txCommit(hw, st);
+        space = usbSerialJtag_txFree(hw);
+    }
+
+    STATS_ADD(st, txFifoFull, (space == 0 && txPending()) ? 1U : 0U);
+}
+
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+/**
+ * @brief Drop the data of the previous session after a bus reset (ISR side)
+ *
+ * The ISR consumes the TX side itself. It produces the RX ring, so it only records the head,
+ * and the consumer drops the bytes before that head on its next read.
+ */
+static void isrFlush(void)
+{
+    usbSerialJtag_ringConsume(&txRing, usbSerialJtag_ringCount(&txRing));
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+    usbSerialJtag_txqFlush();
+#endif
+#if USB_SERIAL_JTAG_CFG_LOG_ENABLE
+    usbSerialJtag_logFlush();
+#endif
+#if USB_SERIAL_JTAG_CFG_MUX_ENABLE
+    usbSerialJtag_muxFlush();
+#endif
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    txOpen = 0;
+    txAge = 0;
+#endif
+    usbSerialJtag_rxReset();
+    rxStalled = 0;
+    __atomic_store_n(&rxKick, 0U, __ATOMIC_RELAXED);
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+    rxPolling = 0;
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+#endif
+    __atomic_store_n(&rxFlushHead, rxRing.head, __ATOMIC_RELEASE);
+}
+#endif
+
+/**
+ * @brief Drop the RX bytes received before the last bus reset (consumer side)
+ */
+static inline void rxDropStale(void)
+{
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    // Wraps past the ring count once the tail is beyond the flush point
+    uint32_t stale = __atomic_load_n(&rxFlushHead, __ATOMIC_ACQUIRE) - rxRing.tail;
+    if (stale != 0 && stale <= usbSerialJtag_ringCount(&rxRing)) {
+        usbSerialJtag_ringConsume(&rxRing, stale);
+    }
+#endif
+}
+
+
+void usbSerialJtag_isrInit(void)
+{
+    usbSerialJtag_ringInit(&txRing, txStorage, USB_SERIAL_JTAG_CFG_TX_RING_SIZE);
+    usbSerialJtag_ringInit(&rxRing, rxStorage, USB_SERIAL_JTAG_CFG_RX_RING_SIZE);
+    rxStalled = 0;
+    rxKick = 0;
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+    rxPolling = 0;
+#endif
+    usbSerialJtag_cyclesInit();
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+    usbSerialJtag_statsSetRxModeration(rxModPackets, rxModCycles / (uint32_t) kUSB_SERIAL_JTAG_CYCLES_PER_US);
+#endif
+    hostTokenCycles = usbSerialJtag_cycles();
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+    usbSerialJtag_txqInit();
+#endif
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    rxFlushHead = 0;
+    usbSerialJtag_recoverInit();
+#endif
+
+    // SOF_INT is enabled by the ISR while it has a drain paced by the frames pending
+    setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT | mISR_RX_SOF);
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    txOpen = 0;
+    txAge = 0;
+    setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_SOF_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT);
+#endif
+#if USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE
+    setUSB_SERIAL_JTAG_INT_CLR(mISR_RESYNC);
+    setUSB_SERIAL_JTAG_INT_ENA(mISR_RESYNC);
+#endif
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+    usbSerialJtag_lineInit();
+    setUSB_SERIAL_JTAG_INT_CLR(mUSB_SERIAL_JTAG_LINE_EVENTS);
+    setUSB_SERIAL_JTAG_INT_ENA(mUSB_SERIAL_JTAG_LINE_EVENTS);
+#endif
+#if USB_SERIAL_JTAG_CFG_JTAG_ENABLE
+    setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_IN_FLUSH_INT);
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_IN_FLUSH_INT);
+#endif
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    // SOF_INT is enabled by the ISR while a recovery waits for the end of the bus reset
+    setUSB_SERIAL_JTAG_INT_CLR(mISR_RECOVER);
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_USB_BUS_RESET_INT);
+#endif
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+    // The error sources are only latched in intRawReg, they are enabled to be counted as they occur
+    setUSB_SERIAL_JTAG_INT_CLR(mUSB_SERIAL_JTAG_STATS_EVENTS);
+    setUSB_SERIAL_JTAG_INT_ENA(mUSB_SERIAL_JTAG_STATS_EVENTS);
+#endif
+}
+
+void usbSerialJtag_isrDeinit(void)
+{
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT | mISR_RX_SOF);
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_SOF_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT);
+    if (txOpen != 0) {
+        // The bytes of an open packet are not left behind in the FIFO
+        __usbSerialJtag_stats_t ignore = { 0 };
+        txCommit(usbSerialJtag_hw(), &ignore);
+    }
+#endif
+#if USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE
+    clrUSB_SERIAL_JTAG_INT_ENA(mISR_RESYNC);
+#endif
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSB_SERIAL_JTAG_LINE_EVENTS);
+#endif
+#if USB_SERIAL_JTAG_CFG_JTAG_ENABLE
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_IN_FLUSH_INT);
+#endif
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    clrUSB_SERIAL_JTAG_INT_ENA(mISR_RECOVER);
+#endif
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSB_SERIAL_JTAG_STATS_EVENTS);
+#endif
+}
+
+void usbSerialJtag_isrHandler(void)
+{
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+    uint32_t entry = usbSerialJtag_cycles();
+#endif
+    __usbSerialJtag_t *hw = usbSerialJtag_hw();
+    __usbSerialJtag_stats_t delta = { 0 };
+    uint32_t status = usbSerialJtag_intStSnapshot().WORD;
+    uint32_t rxSof = status & mISR_RX_SOF;
+    setUSB_SERIAL_JTAG_INT_CLR(status & mISR_SOURCES);
+
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+    // Events raised while the ISR runs are counted by the next entry, the served sources that are
+    // also counted were already cleared from intRawReg
+    uint32_t events = (usbSerialJtag_intRawSnapshot().WORD | status) & mUSB_SERIAL_JTAG_STATS_EVENTS;
+    setUSB_SERIAL_JTAG_INT_CLR(events);
+#endif
+
+#if USB_SERIAL_JTAG_CFG_RECOVER_ENABLE
+    if (status & mUSBSERIALJTAG_INTSTATUSREG_USB_BUS_RESET_INT) {
+        usbSerialJtag_recoverOnBusReset();
+        isrFlush();
+    }
+    if ((status & mUSBSERIALJTAG_INTSTATUSREG_SOF_INT) && usbSerialJtag_recoverState() != kUSB_SERIAL_JTAG_RECOVER_IDLE) {
+        usbSerialJtag_recoverOnSof();
+        if (usbSerialJtag_recoverState() == kUSB_SERIAL_JTAG_RECOVER_IDLE) {
+            // The data queued while the FIFOs were held in reset is sent now
+            usbSerialJtag_isrKickTx();
+        }
+    }
+    if (usbSerialJtag_recoverState() != kUSB_SERIAL_JTAG_RECOVER_IDLE) {
+        // Nothing is moved through FIFOs held in reset
+        status &= ~mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT;
+        rxSof = 0;
+    }
+#endif
+
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+    // Before the TX path, so a DTR rise is seen by the fill of this entry
+    if (status & mUSB_SERIAL_JTAG_LINE_EVENTS) {
+        if (usbSerialJtag_lineOnEvents(status & mUSB_SERIAL_JTAG_LINE_EVENTS)) {
+            usbSerialJtag_isrKickTx();
+        }
+    }
+#endif
+
+    if (rxSof) {
+        uint32_t drained = 0;
+#if USB_SERIAL_JTAG_CFG_OTA_ENABLE
+        uint32_t ota = usbSerialJtag_otaActive();
+#else
+        uint32_t ota = 0;
+#endif
+        // Before the OUT_RECV path, so a round started by this entry waits for the next frame
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+        if (rxPolling && ota) {
+            // The image is not drained to the RX ring, the next entry hands it to the update
+            rxPollEnd(hw, &delta, 0);
+        } else if (rxPolling) {
+            drained = rxPollSof(hw, &delta);
+        }
+#endif
+        if (__atomic_load_n(&rxKick, __ATOMIC_ACQUIRE)) {
+            // The data left in the FIFO (stalled ring, end of a firmware image) is moved now
+            __atomic_store_n(&rxKick, 0U, __ATOMIC_RELAXED);
+            if (!ota) {
+                uint32_t first = usbSerialJtag_rxPacketCount();
+                rxStalled = rxDrain(hw, &delta);
+                drained += usbSerialJtag_rxPacketCount() - first;
+            }
+        }
+#if USB_SERIAL_JTAG_CFG_ASYNC_ENABLE
+        if (drained != 0) {
+            usbSerialJtag_asyncOnRx();
+        }
+#else
+        (void) drained;
+#endif
+    }
+
+#if USB_SERIAL_JTAG_CFG_OTA_ENABLE
+    if ((status & mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT) && usbSerialJtag_otaActive()) {
+        // The image goes to the flash page buffers, not to the RX ring. The bytes that follow the
+        // end of the image in its last packet are drained to the RX ring below
+        usbSerialJtag_otaOnRx(hw);
+        if (usbSerialJtag_otaActive() || !(usbSerialJtag_hwRegRead(hw, ep1ConfReg) & mUSBSERIALJTAG_EP1CONFREG_SERIAL_OUT_EP_DATA_AVAIL)) {
+            status &= ~mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT;
+        }
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+        usbSerialJtag_latRecord(kUSB_SERIAL_JTAG_LAT_RX, usbSerialJtag_cycles() - entry);
+#endif
+    }
+#endif
+
+    if (status & mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT) {
+        if (rxDrain(hw, &delta)) {
+            rxStalled = 1;
+        }
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+        else {
+            rxPollEnter(&delta);
+        }
+#endif
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+        usbSerialJtag_latRecord(kUSB_SERIAL_JTAG_LAT_RX, usbSerialJtag_cycles() - entry);
+#endif
+#if USB_SERIAL_JTAG_CFG_ASYNC_ENABLE
+        usbSerialJtag_asyncOnRx();
+#endif
+    }
+
+#if USB_SERIAL_JTAG_CFG_FRAME_RESYNC_ENABLE
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+    if ((status & mISR_RESYNC) && !rxStalled && !rxPolling) {
+#else
+    if ((status & mISR_RESYNC) && !rxStalled) {
+#endif
+        // After the data drained above (not while data is held in the FIFO, it would be reordered):
+        // the decoder of the application restarts at a frame boundary
+        uint8_t delim = (uint8_t) USB_SERIAL_JTAG_CFG_FRAME_RESYNC_BYTE;
+        (void) usbSerialJtag_ringPut(&rxRing, &delim, 1);
+    }
+#endif
+
+    if (status & mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT) {
+        txFill(hw, &delta);
+        if (!txPending() || txPaused()) {
+            clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT);
+        }
+    }
+
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    if (status & mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT) {
+        // The host polls EP1: top up the open packet with the data queued since the last fill,
+        // one poll per kick so the NAKed tokens do not flood the CPU
+        clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT);
+        txFill(hw, &delta);
+    }
+
+    if ((status & mUSBSERIALJTAG_INTSTATUSREG_SOF_INT) && txOpen != 0) {
+        if (++txAge >= USB_SERIAL_JTAG_CFG_SOF_FLUSH_FRAMES) {
+            txFill(hw, &delta);
+            if (txOpen != 0) {
+                txCommit(hw, &delta);
+            }
+        }
+    }
+#endif
+
+    // SOF_INT is only served while an RX drain is paced by the frames, a packet is open or a
+    // recovery waits for the end of a bus reset
+    if (sofWanted()) {
+        setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_SOF_INT);
+    } else {
+        clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_SOF_INT);
+    }
+
+#if USB_SERIAL_JTAG_CFG_JTAG_ENABLE
+    if (status & mUSBSERIALJTAG_INTSTATUSREG_IN_FLUSH_INT) {
+        usbSerialJtag_jtagOnFlush();
+    }
+#endif
+
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+    usbSerialJtag_statsAdd(events, &delta);
+#endif
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+    usbSerialJtag_latRecord(kUSB_SERIAL_JTAG_LAT_ISR, usbSerialJtag_cycles() - entry);
+#endif
+}
+
+size_t usbSerialJtag_isrWrite(const uint8_t *buf, size_t len)
+{
+    size_t queued = usbSerialJtag_ringPut(&txRing, buf, len);
+
+    if (queued != 0) {
+        usbSerialJtag_isrKickTx();
+    }
+    return queued;
+}
+
+size_t usbSerialJtag_isrWritePolicy(const uint8_t *buf, size_t len, uint32_t policy, uint32_t timeoutUs)
+{
+    size_t queued = usbSerialJtag_isrWrite(buf, len);
+
+    if (queued == len) {
+        return queued;
+    }
+
+    if (policy == kUSB_SERIAL_JTAG_TX_DROP_OLDEST) {
+        // Only the newest bytes of a buffer larger than the ring are kept
+        size_t skip = 0;
+        if (len - queued > USB_SERIAL_JTAG_CFG_TX_RING_SIZE) {
+            skip = len - queued - USB_SERIAL_JTAG_CFG_TX_RING_SIZE;
+        }
+
+        // The ISR is the consumer of the ring (TX fill, bus reset flush): no handler runs while
+        // the tail moves, so it keeps a single writer at any time
+        uint32_t need = (uint32_t) (len - queued - skip);
+        uint32_t key = usbSerialJtag_irqLock();
+        uint32_t room = usbSerialJtag_ringFree(&txRing);
+        uint32_t drop = (need > room) ? need - room : 0U;
+        usbSerialJtag_ringConsume(&txRing, drop);
+        usbSerialJtag_irqUnlock(key);
+
+        txDropped += drop + (uint32_t) skip;
+        queued += skip + usbSerialJtag_isrWrite(&buf[queued + skip], need);
+        return queued;
+    }
+
+    if (policy == kUSB_SERIAL_JTAG_TX_BLOCK) {
+        // The cycle counter wraps every 2^32 cycles (26.8 s at 160 MHz), the elapsed time is
+        // accumulated in 64 bits from the short intervals between two iterations
+        uint64_t limit = (uint64_t) timeoutUs * kUSB_SERIAL_JTAG_CYCLES_PER_US;
+        uint64_t elapsed = 0;
+        uint32_t last = usbSerialJtag_cycles();
+
+        while (queued < len && usbSerialJtag_isrHostPresent() && elapsed < limit) {
+            queued += usbSerialJtag_isrWrite(&buf[queued], len - queued);
+            uint32_t now = usbSerialJtag_cycles();
+            elapsed += now - last;
+            last = now;
+        }
+    }
+
+    txDropped += (uint32_t) (len - queued);
+    return queued;
+}
+
+uint32_t usbSerialJtag_isrHostPresent(void)
+{
+#if USB_SERIAL_JTAG_CFG_LINE_ENABLE
+    if (usbSerialJtag_lineTxPaused()) {
+        return 0;
+    }
+#endif
+
+    uint32_t now = usbSerialJtag_cycles();
+
+    // The raw status latches the token whether the interrupt is enabled or not
+    if (usbSerialJtag_intRawSnapshot().WORD & mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT) {
+        // When the SOF flush scheduler has the source enabled, the interrupt is taken before this
+        // clear can hide it
+        setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT);
+        hostTokenCycles = now;
+        return 1;
+    }
+
+    // The host only sends IN tokens while data is committed or it waits for data
+    if (!txPending()) {
+        hostTokenCycles = now;
+        return 1;
+    }
+    return (now - hostTokenCycles < kHOST_IDLE_CYCLES) ? 1U : 0U;
+}
+
+uint32_t usbSerialJtag_isrTxDropped(void)
+{
+    return txDropped;
+}
+
+void usbSerialJtag_isrKickTx(void)
+{
+#if USB_SERIAL_JTAG_CFG_LAT_ENABLE
+    usbSerialJtag_latTxQueued();
+#endif
+    // The ISR fills the FIFO as soon as it reports empty
+#if USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT | mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT);
+#else
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT);
+#endif
+}
+
+void usbSerialJtag_isrKickRx(void)
+{
+    __atomic_store_n(&rxKick, 1U, __ATOMIC_RELEASE);
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_SOF_INT);
+}
+
+void usbSerialJtag_isrSetRxModeration(uint32_t packets, uint32_t us)
+{
+    __atomic_store_n(&rxModPackets, packets, __ATOMIC_RELAXED);
+    __atomic_store_n(&rxModCycles, us * (uint32_t) kUSB_SERIAL_JTAG_CYCLES_PER_US, __ATOMIC_RELAXED);
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+    usbSerialJtag_statsSetRxModeration(packets, us);
+#endif
+}
+
+size_t usbSerialJtag_isrRead(uint8_t *buf, size_t max)
+{
+    rxDropStale();
+    size_t got = usbSerialJtag_ringGet(&rxRing, buf, max);
+
+    if (rxStalled && got != 0) {
+        // The interrupt already fired for the data left in the FIFO: the ISR, the only producer of
+        // the ring, moves it on the next SOF_INT
+        usbSerialJtag_isrKickRx();
+    }
+    return got;
+}
+
+uint32_t usbSerialJtag_isrTxPending(void)
+{
+    return usbSerialJtag_ringCount(&txRing);
+}
+
+uint32_t usbSerialJtag_isrTxFree(void)
+{
+    return usbSerialJtag_ringFree(&txRing);
+}
+
+uint32_t usbSerialJtag_isrRxAvailable(void)
+{
+    rxDropStale();
+    return usbSerialJtag_ringCount(&rxRing);
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_ISR.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Interrupt driven CDC-ACM driver for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the interrupt driven driver of the CDC-ACM channel. The received
+ * packets are moved to an RX ring on SERIAL_OUT_RECV_PKT_INT and the TX ring is moved to the FIFO
+ * on SERIAL_IN_EMPTY_INT, so the application never polls the FIFO status.
+ *
+ * The driver does not own the interrupt controller: the application routes the USB Serial JTAG
+ * interrupt source to a CPU interrupt and calls usbSerialJtag_isrHandler from its vector.
+ *
+ * The sizes of the rings are set with USB_SERIAL_JTAG_CFG_TX_RING_SIZE and
+ * USB_SERIAL_JTAG_CFG_RX_RING_SIZE (see USB_SERIAL_JTAG_ESP32-C6_CONFIG.h).
+ *
+ * With USB_SERIAL_JTAG_CFG_SOF_FLUSH_ENABLE a short TX packet is kept open in the FIFO: it is
+ * topped up when the host polls EP1 (IN_TOKEN_REC_IN_EP1_INT) after new data was queued, committed
+ * as soon as it holds 64 bytes and otherwise committed on the SOF_INT that ends its
+ * USB_SERIAL_JTAG_CFG_SOF_FLUSH_FRAMES-th frame.
+ *
+ * With USB_SERIAL_JTAG_CFG_LINE_ENABLE the line state events are served too and, unless
+ * USB_SERIAL_JTAG_CFG_LINE_TX_PAUSE is 0, the TX data stays in the ring while DTR is low (see
+ * USB_SERIAL_JTAG_ESP32-C6_LINE.h).
+ *
+ * With USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE the ISR entry of a received packet masks
+ * SERIAL_OUT_RECV_PKT_INT and returns. The next packets of the burst are drained by the ISR on
+ * SOF_INT, one entry per frame instead of one per packet, until a frame brings no packet or the
+ * round reaches its packet budget or time limit (usbSerialJtag_isrSetRxModeration). The interrupt
+ * is unmasked again then, whether the application reads or not.
+ *
+ * The ISR is the only producer of the RX ring. When the ring is full the packet is left in the
+ * FIFO (the host is NAKed), the read that frees room has it moved by the ISR on the next SOF_INT.
+ *
+ * With USB_SERIAL_JTAG_CFG_MUX_ENABLE the cells of the virtual channels are scheduled into the
+ * packets as well, a cell in progress is finished before any other TX data is pushed (see
+ * USB_SERIAL_JTAG_ESP32-C6_MUX.h).
+ *
+ * With USB_SERIAL_JTAG_CFG_OTA_ENABLE the OUT packets of a firmware image go to the flash page
+ * buffers instead of the RX ring while an update runs (see USB_SERIAL_JTAG_ESP32-C6_OTA.h).
+ *
+ * With USB_SERIAL_JTAG_CFG_LAT_ENABLE the ISR duration, the RX drain and the TX kick to WR_DONE
+ * latencies are accumulated in histograms (see USB_SERIAL_JTAG_ESP32-C6_LAT.h).
+ *
+ * With USB_SERIAL_JTAG_CFG_RECOVER_ENABLE a USB_BUS_RESET_INT drops the data of the previous
+ * session (rings, TX descriptors, FIFOs) and the TX data queued afterwards is held until the
+ * FIFOs are recovered (see USB_SERIAL_JTAG_ESP32-C6_RECOVER.h).
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_ISR_H
+#define USB_SERIAL_JTAG_ESP32_C6_ISR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * TX backpressure policies of usbSerialJtag_isrWritePolicy
+ */
+#define kUSB_SERIAL_JTAG_TX_DROP_NEWEST 0U // Queue what fits, the rest of the buffer is dropped
+#define kUSB_SERIAL_JTAG_TX_DROP_OLDEST 1U // Drop the oldest bytes of the TX ring to make room for the buffer
+#define kUSB_SERIAL_JTAG_TX_BLOCK 2U // Wait for room up to a timeout, return early when the host is absent
+
+/**
+ * @brief Initialize the rings and enable the CDC-ACM interrupts
+ */
+void usbSerialJtag_isrInit(void);
+
+/**
+ * @brief Disable the CDC-ACM interrupts handled by the driver and commit an open TX packet
+ */
+void usbSerialJtag_isrDeinit(void);
+
+/**
+ * @brief Interrupt handler, to be called from the CPU interrupt routed to the USB Serial JTAG source
+ */
+void usbSerialJtag_isrHandler(void);
+
+/**
+ * @brief Queue data in the TX ring (single producer)
+ *
+ * @param buf Pointer to the data to be sent
+ * @param len Number of bytes to be sent
+ * @return size_t Number of bytes queued (less than len if the ring is full)
+ */
+size_t usbSerialJtag_isrWrite(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Queue data in the TX ring with a backpressure policy (single producer)
+ *
+ * None of the policies waits on the FIFO: kUSB_SERIAL_JTAG_TX_BLOCK waits for room in the ring at
+ * most timeoutUs, and not at all once usbSerialJtag_isrHostPresent reports the host absent.
+ *
+ * kUSB_SERIAL_JTAG_TX_DROP_OLDEST masks the interrupts of the core while it moves the tail of the
+ * ring (usbSerialJtag_irqLock), it must not be called from an interrupt that can preempt the USB
+ * Serial JTAG ISR. A buffer larger than the ring keeps its newest bytes.
+ *
+ * @param buf Pointer to the data to be sent
+ * @param len Number of bytes to be sent
+ * @param policy kUSB_SERIAL_JTAG_TX_DROP_NEWEST, kUSB_SERIAL_JTAG_TX_DROP_OLDEST or kUSB_SERIAL_JTAG_TX_BLOCK
+ * @param timeoutUs Max wait of kUSB_SERIAL_JTAG_TX_BLOCK in microseconds (the whole uint32_t range, about 71 minutes)
+ * @return size_t Number of bytes of buf queued
+ */
+size_t usbSerialJtag_isrWritePolicy(const uint8_t *buf, size_t len, uint32_t policy, uint32_t timeoutUs);
+
+/**
+ * @brief Whether a host is reading the CDC-ACM channel
+ *
+ * The host is absent when DTR is low (USB_SERIAL_JTAG_CFG_LINE_ENABLE) or when no IN token was
+ * received on EP1 for USB_SERIAL_JTAG_CFG_TX_HOST_IDLE_MS while TX data is pending. The IN token
+ * activity is taken from intRawReg, so IN_TOKEN_REC_IN_EP1_INT does not need to be enabled.
+ *
+ * @return uint32_t 1 if the host is present
+ */
+uint32_t usbSerialJtag_isrHostPresent(void);
+
+/**
+ * @brief Number of TX bytes dropped by the backpressure policies
+ *
+ * @return uint32_t Free-running counter
+ */
+uint32_t usbSerialJtag_isrTxDropped(void);
+
+/**
+ * @brief Enable SERIAL_IN_EMPTY_INT (and IN_TOKEN_REC_IN_EP1_INT with the SOF flush scheduler) so the
+ * ISR moves the pending TX data to the FIFO (producer side)
+ */
+void usbSerialJtag_isrKickTx(void);
+
+/**
+ * @brief Have the ISR move the data left in the OUT FIFO to the RX ring on the next SOF_INT
+ *
+ * For data whose SERIAL_OUT_RECV_PKT_INT was already served (RX ring full, end of a firmware
+ * image drained by the task), the ISR stays the only producer of the RX ring.
+ */
+void usbSerialJtag_isrKickRx(void);
+
+/**
+ * @brief Set the RX moderation thresholds (needs USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE)
+ *
+ * A round ends once its SOF_INT drained packets packets, once us microseconds have
+ * elapsed since the ISR entry that started it, or on the first frame that brings no packet. The
+ * limits are checked on every SOF_INT of the round, a round therefore lasts at least up to the
+ * next frame: the host is NAKed for at most one frame after us.
+ *
+ * @param packets Max packets drained by the SOF_INT of a round, 0 to disable
+ * @param us Max length of a round in microseconds
+ */
+void usbSerialJtag_isrSetRxModeration(uint32_t packets, uint32_t us);
+
+/**
+ * @brief Take data from the RX ring (single consumer)
+ *
+ * @param buf Pointer to the buffer where the data is stored
+ * @param max Size of the buffer
+ * @return size_t Number of bytes read
+ */
+size_t usbSerialJtag_isrRead(uint8_t *buf, size_t max);
+
+/**
+ * @brief Number of bytes waiting in the TX ring
+ */
+uint32_t usbSerialJtag_isrTxPending(void);
+
+/**
+ * @brief Number of bytes that can be queued in the TX ring
+ */
+uint32_t usbSerialJtag_isrTxFree(void);
+
+/**
+ * @brief Number of bytes waiting in the RX ring
+ */
+uint32_t usbSerialJtag_isrRxAvailable(void);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_ISR_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_JTAG.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief JTAG bridge FIFO monitor of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include <stddef.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_JTAG.h"
+
+#define mJTAG_IDLE (mUSBSERIALJTAG_JFIFOSTREG_IN_FIFO_EMPTY | mUSBSERIALJTAG_JFIFOSTREG_OUT_FIFO_EMPTY)
+
+static uint32_t flushCount = 0; // Written by the ISR
+static __usbSerialJtag_jtagFlushCb_t flushCb = NULL;
+static void *flushArg = NULL;
+
+
+void usbSerialJtag_jtagStatus(__usbSerialJtag_jtagStatus_t *out)
+{
+    uint32_t st = usbSerialJtag_jfifoStSnapshot().WORD;
+
+    out->inCount = (uint8_t) usbSerialJtag_fieldGet(st, mUSBSERIALJTAG_JFIFOSTREG_IN_FIFO_CNT);
+    out->outCount = (uint8_t) usbSerialJtag_fieldGet(st, mUSBSERIALJTAG_JFIFOSTREG_OUT_FIFO_CNT);
+    out->inEmpty = (uint8_t) usbSerialJtag_fieldGet(st, mUSBSERIALJTAG_JFIFOSTREG_IN_FIFO_EMPTY);
+    out->inFull = (uint8_t) usbSerialJtag_fieldGet(st, mUSBSERIALJTAG_JFIFOSTREG_IN_FIFO_FULL);
+    out->outEmpty = (uint8_t) usbSerialJtag_fieldGet(st, mUSBSERIALJTAG_JFIFOSTREG_OUT_FIFO_EMPTY);
+    out->outFull = (uint8_t) usbSerialJtag_fieldGet(st, mUSBSERIALJTAG_JFIFOSTREG_OUT_FIFO_FULL);
+}
+
+uint32_t usbSerialJtag_jtagIdle(void)
+{
+    return ((usbSerialJtag_jfifoStSnapshot().WORD & mJTAG_IDLE) == mJTAG_IDLE) ? 1U : 0U;
+}
+
+int usbSerialJtag_jtagWaitIdle(uint32_t maxPolls)
+{
+    for (uint32_t i = 0; i < maxPolls; i++) {
+        if (usbSerialJtag_jtagIdle()) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void usbSerialJtag_jtagFifoReset(uint32_t fifos)
+{
+    // The reset bits are levels: pulse them, the other bits of the register are kept
+    fifos &= mUSB_SERIAL_JTAG_JTAG_IN_FIFO | mUSB_SERIAL_JTAG_JTAG_OUT_FIFO;
+    setUSB_SERIAL_JTAG_JFIFO_ST(fifos);
+    clrUSB_SERIAL_JTAG_JFIFO_ST(fifos);
+}
+
+void usbSerialJtag_jtagBridgeEnable(uint32_t enable)
+{
+    if (enable) {
+        setUSB_SERIAL_JTAG_CONF0(mUSBSERIALJTAG_CONF0REG_USB_JTAG_BRIDGE_EN);
+    } else {
+        clrUSB_SERIAL_JTAG_CONF0(mUSBSERIALJTAG_CONF0REG_USB_JTAG_BRIDGE_EN);
+    }
+}
+
+void usbSerialJtag_jtagSetFlushCallback(__usbSerialJtag_jtagFlushCb_t cb, void *arg)
+{
+    // Remove the callback first, so the ISR never calls cb with the previous argument
+    __atomic_store_n(&flushCb, NULL, __ATOMIC_RELEASE);
+    flushArg = arg;
+    __atomic_store_n(&flushCb, cb, __ATOMIC_RELEASE);
+}
+
+uint32_t usbSerialJtag_jtagFlushCount(void)
+{
+    return __atomic_load_n(&flushCount, __ATOMIC_ACQUIRE);
+}
+
+void usbSerialJtag_jtagOnFlush(void)
+{
+    __usbSerialJtag_jtagFlushCb_t cb = __atomic_load_n(&flushCb, __ATOMIC_ACQUIRE);
+
+    __atomic_store_n(&flushCount, flushCount + 1U, __ATOMIC_RELEASE);
+    if (cb != NULL) {
+        cb(flushArg);
+    }
+}
\ No newline at end of file
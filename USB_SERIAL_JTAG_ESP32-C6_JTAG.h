@@ -0,0 +1,111 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_JTAG.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief JTAG bridge FIFO monitor of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the functions that supervise the JTAG FIFOs of the controller. The
+ * IN/OUT JTAG FIFOs are fed by the USB JTAG endpoint (EP2) and drained by the JTAG engine in
+ * hardware, there is no CPU data port: the CPU can only observe them through jfifoStReg, reset them
+ * and route the JTAG signals (USB_JTAG_BRIDGE_EN).
+ *
+ * Every status function takes a single snapshot of jfifoStReg, so the counters and the flags of a
+ * decision come from the same read. JTAG_IN_FLUSH_INT is counted by the interrupt driver when
+ * USB_SERIAL_JTAG_CFG_JTAG_ENABLE is 1, so a probe flow can wait for a flush without polling the
+ * FIFO flags.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_JTAG_H
+#define USB_SERIAL_JTAG_ESP32_C6_JTAG_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Masks of the JTAG FIFOs for usbSerialJtag_jtagFifoReset
+ */
+#define mUSB_SERIAL_JTAG_JTAG_IN_FIFO mUSBSERIALJTAG_JFIFOSTREG_IN_FIFO_RESET // JTAG IN FIFO (host to TAP)
+#define mUSB_SERIAL_JTAG_JTAG_OUT_FIFO mUSBSERIALJTAG_JFIFOSTREG_OUT_FIFO_RESET // JTAG OUT FIFO (TAP to host)
+
+/**
+ * \typedef __usbSerialJtag_jtagStatus_t
+ * Decoded status of the JTAG FIFOs, taken from one read of jfifoStReg
+ */
+typedef struct {
+    uint8_t inCount; // Entries in the IN FIFO
+    uint8_t outCount; // Entries in the OUT FIFO
+    uint8_t inEmpty; // IN FIFO empty
+    uint8_t inFull; // IN FIFO full
+    uint8_t outEmpty; // OUT FIFO empty
+    uint8_t outFull; // OUT FIFO full
+} __usbSerialJtag_jtagStatus_t;
+
+/**
+ * @brief Flush event callback, called from the ISR on JTAG_IN_FLUSH_INT
+ */
+typedef void (*__usbSerialJtag_jtagFlushCb_t)(void *arg);
+
+
+/**
+ * @brief Read and decode the status of the JTAG FIFOs (one register read)
+ *
+ * @param out Decoded status
+ */
+void usbSerialJtag_jtagStatus(__usbSerialJtag_jtagStatus_t *out);
+
+/**
+ * @brief Whether both JTAG FIFOs are empty (one register read)
+ *
+ * @return uint32_t 1 if the IN and OUT FIFOs are empty
+ */
+uint32_t usbSerialJtag_jtagIdle(void);
+
+/**
+ * @brief Wait until both JTAG FIFOs are empty
+ *
+ * @param maxPolls Max number of status reads
+ * @return int 0 when the FIFOs are empty, -1 on timeout
+ */
+int usbSerialJtag_jtagWaitIdle(uint32_t maxPolls);
+
+/**
+ * @brief Reset JTAG FIFOs
+ *
+ * @param fifos mUSB_SERIAL_JTAG_JTAG_IN_FIFO and/or mUSB_SERIAL_JTAG_JTAG_OUT_FIFO
+ */
+void usbSerialJtag_jtagFifoReset(uint32_t fifos);
+
+/**
+ * @brief Route the USB JTAG to the GPIO pins instead of the internal JTAG of the CPU
+ *
+ * @param enable 1 to disconnect usb_jtag from the internal JTAG
+ */
+void usbSerialJtag_jtagBridgeEnable(uint32_t enable);
+
+/**
+ * @brief Set the callback of the JTAG_IN_FLUSH_INT event
+ *
+ * @param cb Callback (NULL to remove it)
+ * @param arg Argument of the callback
+ */
+void usbSerialJtag_jtagSetFlushCallback(__usbSerialJtag_jtagFlushCb_t cb, void *arg);
+
+/**
+ * @brief Number of JTAG_IN_FLUSH_INT events counted by the ISR
+ *
+ * @return uint32_t Free-running event counter
+ */
+uint32_t usbSerialJtag_jtagFlushCount(void);
+
+/**
+ * @brief Count a JTAG_IN_FLUSH_INT event and call the callback (ISR side)
+ */
+void usbSerialJtag_jtagOnFlush(void);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_JTAG_H
\ No newline at end of file
@@ -0,0 +1,151 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LAT.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Latency histograms of the ESP32-C6 USB Serial JTAG driver
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * A value below 2^S (S sub-bucket bits) has its own bucket. Above, the bucket is made of the
+ * position of the leading one and the S bits that follow it, so every power of two is split in
+ * 2^S buckets of equal width. The counters are only added with atomic adds, the ISR and the
+ * application can record in the same path.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LAT.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+
+_Static_assert(USB_SERIAL_JTAG_CFG_LAT_SUB_BITS >= 1U && USB_SERIAL_JTAG_CFG_LAT_SUB_BITS <= 4U, "Latency sub-bucket bits must be 1 to 4");
+
+#define kLAT_SUB USB_SERIAL_JTAG_CFG_LAT_SUB_BITS
+#define kLAT_SUB_MASK ((1UL << kLAT_SUB) - 1U)
+#define kLAT_WORDS (sizeof(__usbSerialJtag_latHist_t) / sizeof(uint32_t)) // Words of one histogram
+
+static __usbSerialJtag_latHist_t hists[kUSB_SERIAL_JTAG_LAT_PATHS];
+static uint32_t txStamp = 0; // Cycle count of the oldest TX kick since the last WR_DONE, 0 if none
+
+
+static inline uint32_t latBucket(uint32_t cycles)
+{
+    if (cycles <= kLAT_SUB_MASK) {
+        return cycles;
+    }
+
+    uint32_t msb = 31U - (uint32_t) __builtin_clz(cycles);
+    return ((msb - kLAT_SUB + 1U) << kLAT_SUB) | ((cycles >> (msb - kLAT_SUB)) & kLAT_SUB_MASK);
+}
+
+
+void usbSerialJtag_latReset(void)
+{
+    uint32_t *words = (uint32_t *) (void *) hists;
+
+    for (uint32_t i = 0; i < kUSB_SERIAL_JTAG_LAT_PATHS * kLAT_WORDS; i++) {
+        __atomic_store_n(&words[i], 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&txStamp, 0, __ATOMIC_RELAXED);
+}
+
+void usbSerialJtag_latRecord(uint32_t path, uint32_t cycles)
+{
+    if (path >= kUSB_SERIAL_JTAG_LAT_PATHS) {
+        return;
+    }
+
+    __usbSerialJtag_latHist_t *h = &hists[path];
+    uint32_t max = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(&h->bucket[latBucket(cycles)], 1U, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->count, 1U, __ATOMIC_RELAXED);
+    while (cycles > max && !__atomic_compare_exchange_n(&h->max, &max, cycles, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void usbSerialJtag_latTxQueued(void)
+{
+    uint32_t idle = 0;
+
+    // Bit 0 set, so a stamp is never 0 (no kick pending)
+    (void) __atomic_compare_exchange_n(&txStamp, &idle, usbSerialJtag_cycles() | 1U, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+void usbSerialJtag_latTxCommitted(void)
+{
+    uint32_t stamp = __atomic_exchange_n(&txStamp, 0, __ATOMIC_RELAXED);
+
+    if (stamp != 0) {
+        usbSerialJtag_latRecord(kUSB_SERIAL_JTAG_LAT_TX, usbSerialJtag_cycles() - stamp);
+    }
+}
+
+void usbSerialJtag_latSnapshot(uint32_t path, __usbSerialJtag_latHist_t *out)
+{
+    if (path >= kUSB_SERIAL_JTAG_LAT_PATHS) {
+        return;
+    }
+
+    const uint32_t *src = (const uint32_t *) (const void *) &hists[path];
+    uint32_t *dst = (uint32_t *) (void *) out;
+
+    for (uint32_t i = 0; i < kLAT_WORDS; i++) {
+        dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+    }
+}
+
+uint32_t usbSerialJtag_latBucketLow(uint32_t bucket)
+{
+    if (bucket <= kLAT_SUB_MASK) {
+        return bucket;
+    }
+
+    uint32_t msb = (bucket >> kLAT_SUB) + kLAT_SUB - 1U;
+    return (uint32_t) (((1UL << kLAT_SUB) | (bucket & kLAT_SUB_MASK)) << (msb - kLAT_SUB));
+}
+
+uint32_t usbSerialJtag_latPercentile(const __usbSerialJtag_latHist_t *hist, uint32_t permille)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    // Rank of the sample, rounded up so p100 is the last one (split to stay in 32 bits)
+    uint32_t rank = (hist->count / 1000U) * permille + ((hist->count % 1000U) * permille + 999U) / 1000U;
+    uint32_t seen = 0;
+
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (uint32_t b = 0; b < kUSB_SERIAL_JTAG_LAT_BUCKETS; b++) {
+        seen += hist->bucket[b];
+        if (seen >= rank) {
+            uint32_t high = (b + 1U < kUSB_SERIAL_JTAG_LAT_BUCKETS) ? usbSerialJtag_latBucketLow(b + 1U) - 1U : 0xFFFFFFFFUL;
+            return (high < hist->max) ? high : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+size_t usbSerialJtag_latExport(uint8_t *buf, size_t max)
+{
+    if (max < kUSB_SERIAL_JTAG_LAT_EXPORT_SIZE) {
+        return 0;
+    }
+
+    uint32_t hdr[3] = {
+        kUSB_SERIAL_JTAG_LAT_MAGIC,
+        (uint32_t) USB_SERIAL_JTAG_CFG_CPU_FREQ_HZ,
+        kUSB_SERIAL_JTAG_LAT_PATHS | (kLAT_SUB << 8) | (kUSB_SERIAL_JTAG_LAT_BUCKETS << 16),
+    };
+    size_t pos = sizeof(hdr);
+
+    __builtin_memcpy(buf, hdr, sizeof(hdr));
+    for (uint32_t p = 0; p < kUSB_SERIAL_JTAG_LAT_PATHS; p++) {
+        __usbSerialJtag_latHist_t h;
+        usbSerialJtag_latSnapshot(p, &h);
+        __builtin_memcpy(&buf[pos], &h, sizeof(h));
+        pos += sizeof(h);
+    }
+    return pos;
+}
\ No newline at end of file
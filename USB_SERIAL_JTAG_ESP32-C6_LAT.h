@@ -0,0 +1,126 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LAT.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Latency histograms of the ESP32-C6 USB Serial JTAG driver
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the latency instrumentation of the interrupt driver. The latencies
+ * are measured with the cycle counter (USB_SERIAL_JTAG_ESP32-C6_PORT.h) and accumulated in one
+ * log-linear histogram per path: 2^USB_SERIAL_JTAG_CFG_LAT_SUB_BITS buckets per power of two, so a
+ * percentile is known within 25% (2 bits) whatever its magnitude.
+ *
+ * Paths measured by the interrupt driver:
+ * - kUSB_SERIAL_JTAG_LAT_ISR: ISR entry to ISR exit.
+ * - kUSB_SERIAL_JTAG_LAT_RX: ISR entry to the end of the OUT FIFO drain.
+ * - kUSB_SERIAL_JTAG_LAT_TX: oldest TX kick (write, descriptor, log record, cell) since the last
+ *   WR_DONE to the next WR_DONE, SOF flush coalescing included.
+ * - kUSB_SERIAL_JTAG_LAT_APP: free for the application (usbSerialJtag_latRecord), for instance
+ *   request received to response committed.
+ *
+ * The histograms are a fixed RAM block. usbSerialJtag_latExport serializes it for the host,
+ * tools/usb_serial_jtag_lat.py prints the percentiles: little endian words, magic "LATH", CPU
+ * frequency in Hz, then paths (bits 0-7), sub-bucket bits (bits 8-15) and buckets per path (bits
+ * 16-31), then per path the count, the max and the buckets.
+ *
+ * The hooks of the interrupt driver are built when USB_SERIAL_JTAG_CFG_LAT_ENABLE is 1.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_LAT_H
+#define USB_SERIAL_JTAG_ESP32_C6_LAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+
+/**
+ * Measured paths
+ */
+#define kUSB_SERIAL_JTAG_LAT_ISR 0U // ISR entry to exit
+#define kUSB_SERIAL_JTAG_LAT_RX 1U // ISR entry to OUT FIFO drained
+#define kUSB_SERIAL_JTAG_LAT_TX 2U // TX kick to WR_DONE
+#define kUSB_SERIAL_JTAG_LAT_APP 3U // Application defined
+#define kUSB_SERIAL_JTAG_LAT_PATHS 4U
+
+/**
+ * Constant definitions for the histograms
+ */
+#define kUSB_SERIAL_JTAG_LAT_BUCKETS ((33U - USB_SERIAL_JTAG_CFG_LAT_SUB_BITS) << USB_SERIAL_JTAG_CFG_LAT_SUB_BITS) // Buckets of a path (32-bit cycle counts)
+#define kUSB_SERIAL_JTAG_LAT_MAGIC 0x4854414CUL // "LATH"
+#define kUSB_SERIAL_JTAG_LAT_EXPORT_SIZE (12U + kUSB_SERIAL_JTAG_LAT_PATHS * (8U + 4U * kUSB_SERIAL_JTAG_LAT_BUCKETS)) // Bytes of usbSerialJtag_latExport
+
+/**
+ * \typedef __usbSerialJtag_latHist_t
+ * Latency histogram of a path, in CPU cycles
+ */
+typedef struct {
+    uint32_t count; // Samples
+    uint32_t max; // Longest sample
+    uint32_t bucket[kUSB_SERIAL_JTAG_LAT_BUCKETS]; // Samples per bucket (usbSerialJtag_latBucketLow)
+} __usbSerialJtag_latHist_t;
+
+
+/**
+ * @brief Clear the histograms (no sample may be recorded meanwhile)
+ */
+void usbSerialJtag_latReset(void);
+
+/**
+ * @brief Add a sample to a histogram (any context, lock-free)
+ *
+ * @param path kUSB_SERIAL_JTAG_LAT_xxx
+ * @param cycles Latency in CPU cycles
+ */
+void usbSerialJtag_latRecord(uint32_t path, uint32_t cycles);
+
+/**
+ * @brief Start the TX latency of the data queued now, unless older data is waiting (producer side)
+ */
+void usbSerialJtag_latTxQueued(void);
+
+/**
+ * @brief End the TX latency on a WR_DONE (ISR side)
+ */
+void usbSerialJtag_latTxCommitted(void);
+
+/**
+ * @brief Copy the histogram of a path
+ *
+ * The samples recorded during the copy may be partially included.
+ *
+ * @param path kUSB_SERIAL_JTAG_LAT_xxx
+ * @param out Histogram copy
+ */
+void usbSerialJtag_latSnapshot(uint32_t path, __usbSerialJtag_latHist_t *out);
+
+/**
+ * @brief Get the lowest latency of a bucket
+ *
+ * @param bucket Bucket index
+ * @return uint32_t Cycles, the bucket ends where the next one starts
+ */
+uint32_t usbSerialJtag_latBucketLow(uint32_t bucket);
+
+/**
+ * @brief Get a percentile of a histogram
+ *
+ * @param hist Histogram
+ * @param permille Percentile in 1/1000 (990 for p99)
+ * @return uint32_t Upper bound in cycles of the bucket holding the percentile (capped to the max), 0 if empty
+ */
+uint32_t usbSerialJtag_latPercentile(const __usbSerialJtag_latHist_t *hist, uint32_t permille);
+
+/**
+ * @brief Serialize the histograms for the host
+ *
+ * @param buf Destination, at least kUSB_SERIAL_JTAG_LAT_EXPORT_SIZE bytes
+ * @param max Size of buf
+ * @return size_t Bytes written, 0 if buf is too small
+ */
+size_t usbSerialJtag_latExport(uint8_t *buf, size_t max);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_LAT_H
\ No newline at end of file
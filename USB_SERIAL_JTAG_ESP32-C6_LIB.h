@@ -33,10 +33,15 @@
  * 2. Module structure definition
  *    a. Data type
  *    b. Module masks
- *    c. Structure access macro
+ *    c. Register block pointer and structure access macro
  * 3. Register access macros
  *    a. Whole register access macro
  *    b. Bitfields access macro
+ * 4. Register snapshot functions
+ *    a. Field get/set helpers
+ *    b. Register word read and write
+ *    c. Whole register snapshot, commit and modify
+ * 5. Register atomic write macros
  * 
  * 
  *  
@@ -47,6 +52,16 @@
 
 #include <stdint.h>
 
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+
+#if USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_TRACE.h"
+#endif
+
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+#include "sim/usb_serial_jtag_sim.h"
+#endif
+
 /********************************************************************************************************************************
 ************************************************** Configuration Registers ******************************************************
 *********************************************************************************************************************************/
@@ -650,16 +665,74 @@ typedef struct {
 
 } __usbSerialJtag_t;
 
-#define kUSB_SERIAL_JTAG_BASE_ADDR 0x6000F000UL
-#define sUSB_SERIAL_JTAG (*((__usbSerialJtag_t *) kUSB_SERIAL_JTAG_BASE_ADDR))
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+extern __usbSerialJtag_t usbSerialJtag_simRegs; // Host register model (sim/usb_serial_jtag_sim.c)
+#define kUSB_SERIAL_JTAG_BASE_ADDR ((uintptr_t) &usbSerialJtag_simRegs)
+#else
+#define kUSB_SERIAL_JTAG_BASE_ADDR USB_SERIAL_JTAG_CFG_BASE_ADDR
+#endif
+
+/**
+ * \addtogroup USB_SERIAL_JTAG_HANDLE
+ * Register block and register map of the selected chip
+ * @{
+ *
+ * The data path takes the register block as a __usbSerialJtag_t pointer: the bulk CDC-ACM
+ * functions (USB_SERIAL_JTAG_ESP32-C6_CDC.h), the FIFO copy kernels and the fill/drain of the ISR
+ * access the registers and the EP1 FIFO through it, with the usbSerialJtag_hwReg* and
+ * usbSerialJtag_hwEp1* macros. usbSerialJtag_hw returns the block of USB_SERIAL_JTAG_CFG_CHIP, or
+ * the host register model. Every chip has a single USB Serial JTAG controller, so the driver
+ * state (rings, partial OUT packet) is kept once: the ISR loads the pointer once per entry and
+ * hands it down, the task side uses the same block.
+ *
+ * The ESP32-C3 and ESP32-S3 controllers end their map at memConfReg (plus dateReg): the CDC-ACM
+ * line and AFIFO registers, and the driver features built on them, are C6/H2 only.
+ */
+#define kUSB_SERIAL_JTAG_HAS_LINE_REGS (USB_SERIAL_JTAG_CFG_CHIP == kUSB_SERIAL_JTAG_CHIP_ESP32C6 || USB_SERIAL_JTAG_CFG_CHIP == kUSB_SERIAL_JTAG_CHIP_ESP32H2) // chipRstReg to configUpdateReg (DTR/RTS, line coding)
+#define kUSB_SERIAL_JTAG_HAS_AFIFO_REGS (USB_SERIAL_JTAG_CFG_CHIP == kUSB_SERIAL_JTAG_CHIP_ESP32C6 || USB_SERIAL_JTAG_CFG_CHIP == kUSB_SERIAL_JTAG_CHIP_ESP32H2) // serAfifoConficReg and busResetStReg
+
+/**
+ * @brief Register block of the controller of the selected chip
+ *
+ * @return __usbSerialJtag_t* Register block at kUSB_SERIAL_JTAG_BASE_ADDR
+ */
+static inline __usbSerialJtag_t *usbSerialJtag_hw(void)
+{
+    return (__usbSerialJtag_t *) kUSB_SERIAL_JTAG_BASE_ADDR;
+}
+
+#define usbSerialJtag_hwRegRead(hw, reg) __usbSerialJtag_regRead(&(hw)->reg.WORD) // Whole register load through the register block pointer
+#define usbSerialJtag_hwRegWrite(hw, reg, value) __usbSerialJtag_regWrite(&(hw)->reg.WORD, (uint32_t) (value)) // Whole register store through the register block pointer
+#define usbSerialJtag_hwRegSet(hw, reg, mask) __usbSerialJtag_atomicOr(&(hw)->reg.WORD, (uint32_t) (mask)) // Atomic set of the mask bits (RW registers)
+#define usbSerialJtag_hwRegClr(hw, reg, mask) __usbSerialJtag_atomicAnd(&(hw)->reg.WORD, ~(uint32_t) (mask)) // Atomic clear of the mask bits (RW registers)
+#define usbSerialJtag_hwEp1Push(hw, byte) __usbSerialJtag_regWrite(&(hw)->ep1Reg.WORD, (uint32_t) (byte)) // Write a byte to the EP1 FIFO (one store)
+#define usbSerialJtag_hwEp1Pop(hw) __usbSerialJtag_regRead(&(hw)->ep1Reg.WORD) // Read a byte from the EP1 FIFO (one load, the byte is in bits 0-7)
+/** @} */
+
+#define sUSB_SERIAL_JTAG_MMIO (*usbSerialJtag_hw()) // Untraced access, used by the snapshot and atomic helpers
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+#define sUSB_SERIAL_JTAG (*((__usbSerialJtag_t *) usbSerialJtag_simDirect(__func__))) // Synchronizes the register model before the r/b macro access
+#elif USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+#define sUSB_SERIAL_JTAG (*((__usbSerialJtag_t *) usbSerialJtag_traceDirect(__func__))) // Counts the r/b macro accesses of the calling function
+#else
+#define sUSB_SERIAL_JTAG sUSB_SERIAL_JTAG_MMIO
+#endif
 
 
 /**
  * \addtogroup USB_SERIAL_JTAG_EP1_REG
  * @{
  */
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+// The register model needs the direction of every FIFO access: use the push/pop or usbSerialJtag_hwEp1* macros
+#define rUSB_SERIAL_JTAG_EP1 usbSerialJtag_simEp1NeedsPushOrPop
+#define bUSB_SERIAL_JTAG_RDWR_BYTE usbSerialJtag_simEp1NeedsPushOrPop
+#else
 #define rUSB_SERIAL_JTAG_EP1 sUSB_SERIAL_JTAG.ep1Reg.WORD // FIFO access for the CDC-ACM data IN and OUT endpoints
 #define bUSB_SERIAL_JTAG_RDWR_BYTE sUSB_SERIAL_JTAG.ep1Reg.BITS.RDWR_BYTE // 0-7 (R/W) Represents the byte to be written to the FIFO or read from UART TX/RX FIFO
+#endif
+#define pushUSB_SERIAL_JTAG_EP1(byte) usbSerialJtag_hwEp1Push(usbSerialJtag_hw(), byte) // Write a byte to the FIFO (one store)
+#define popUSB_SERIAL_JTAG_EP1() usbSerialJtag_hwEp1Pop(usbSerialJtag_hw()) // Read a byte from the FIFO (one load, the byte is in bits 0-7)
 /** @} */
 
 /**
@@ -756,7 +829,7 @@ typedef struct {
  * @{
  */
 #define rUSB_SERIAL_JTAG_CONFIG_UPDATE sUSB_SERIAL_JTAG.configUpdateReg.WORD // Configuration registers’ value update
-#define bUSB_SERIAL_JTAG_CONFIG_UPDATE sUSB_SERIAL_JTAG.configUpdateReg.BITS.UPDATE // 0 (WT)  Configures whether to update the value of configuration registers from APB clock domain to 48 MHz clock domain
+#define bUSB_SERIAL_JTAG_CONFIG_UPDATE sUSB_SERIAL_JTAG.configUpdateReg.BITS.CONFIG_UPDATE // 0 (WT)  Configures whether to update the value of configuration registers from APB clock domain to 48 MHz clock domain
 /** @} */
 
 /**
@@ -892,39 +965,39 @@ typedef struct {
  * @{
  */
 #define rUSB_SERIAL_JTAG_IN_EP0_ST sUSB_SERIAL_JTAG.inEp0StReg.WORD // Control IN endpoint status information
-#define bUSB_SERIAL_JTAG_IN_EP0_STATE sUSB_SERIAL_JTAG.inEp0StReg.BITS.IN_EP_STATE // 0-1 (RO) Represents state of IN Endpoint 3
-#define bUSB_SERIAL_JTAG_IN_EP0_WR_ADDR sUSB_SERIAL_JTAG.inEp0StReg.BITS.IN_EP_WR_ADDR // 2-8 (RO) Represents write data address of IN endpoint 3
-#define bUSB_SERIAL_JTAG_IN_EP0_RD_ADDR sUSB_SERIAL_JTAG.inEp0StReg.BITS.IN_EP_RD_ADDR // 9-15 (RO) Represents read data address of IN endpoint 3
+#define bUSB_SERIAL_JTAG_IN_EP0_STATE sUSB_SERIAL_JTAG.inEp0StReg.BITS.IN_EPX_STATE // 0-1 (RO) Represents the state of IN endpoint 0
+#define bUSB_SERIAL_JTAG_IN_EP0_WR_ADDR sUSB_SERIAL_JTAG.inEp0StReg.BITS.IN_EPX_WR_ADDR // 2-8 (RO) Represents the write data address of IN endpoint 0
+#define bUSB_SERIAL_JTAG_IN_EP0_RD_ADDR sUSB_SERIAL_JTAG.inEp0StReg.BITS.IN_EPX_RD_ADDR // 9-15 (RO) Represents the read data address of IN endpoint 0
 /** @} */
 
 /**
  * \addtogroup USB_SERIAL_JTAG_IN_EP1_ST_REG
  * @{
- */	
-#define rUSB_SERIAL_JTAG_IN_EP1_ST sUSB_SERIAL_JTAG.inEp1StReg.WORD // Control IN endpoint status information
-#define bUSB_SERIAL_JTAG_IN_EP1_STATE sUSB_SERIAL_JTAG.inEp1StReg.BITS.IN_EP_STATE // 0-1 (RO) Represents state of IN Endpoint 1
-#define bUSB_SERIAL_JTAG_IN_EP1_WR_ADDR sUSB_SERIAL_JTAG.inEp1StReg.BITS.IN_EP_WR_ADDR // 2-8 (RO) Represents write data address of IN endpoint 1
-#define bUSB_SERIAL_JTAG_IN_EP1_RD_ADDR sUSB_SERIAL_JTAG.inEp1StReg.BITS.IN_EP_RD_ADDR // 9-15 (RO) Represents read data address of IN endpoint 1
+ */
+#define rUSB_SERIAL_JTAG_IN_EP1_ST sUSB_SERIAL_JTAG.inEp1StReg.WORD // CDC-ACM IN endpoint status information
+#define bUSB_SERIAL_JTAG_IN_EP1_STATE sUSB_SERIAL_JTAG.inEp1StReg.BITS.IN_EPX_STATE // 0-1 (RO) Represents the state of IN endpoint 1
+#define bUSB_SERIAL_JTAG_IN_EP1_WR_ADDR sUSB_SERIAL_JTAG.inEp1StReg.BITS.IN_EPX_WR_ADDR // 2-8 (RO) Represents the write data address of IN endpoint 1
+#define bUSB_SERIAL_JTAG_IN_EP1_RD_ADDR sUSB_SERIAL_JTAG.inEp1StReg.BITS.IN_EPX_RD_ADDR // 9-15 (RO) Represents the read data address of IN endpoint 1
 /** @} */
 
 /**
  * \addtogroup USB_SERIAL_JTAG_IN_EP2_ST_REG
  * @{
- */	
-#define rUSB_SERIAL_JTAG_IN_EP2_ST sUSB_SERIAL_JTAG.inEp2StReg.WORD // Control IN endpoint status information
-#define bUSB_SERIAL_JTAG_IN_EP2_STATE sUSB_SERIAL_JTAG.inEp2StReg.BITS.IN_EP_STATE // 0-1 (RO) Represents state of IN Endpoint 2
-#define bUSB_SERIAL_JTAG_IN_EP2_WR_ADDR sUSB_SERIAL_JTAG.inEp2StReg.BITS.IN_EP_WR_ADDR // 2-8 (RO) Represents write data address of IN endpoint 2
-#define bUSB_SERIAL_JTAG_IN_EP2_RD_ADDR sUSB_SERIAL_JTAG.inEp2StReg.BITS.IN_EP_RD_ADDR // 9-15 (RO) Represents read data address of IN endpoint 2
+ */
+#define rUSB_SERIAL_JTAG_IN_EP2_ST sUSB_SERIAL_JTAG.inEp2StReg.WORD // CDC-ACM interrupt IN endpoint status information
+#define bUSB_SERIAL_JTAG_IN_EP2_STATE sUSB_SERIAL_JTAG.inEp2StReg.BITS.IN_EPX_STATE // 0-1 (RO) Represents the state of IN endpoint 2
+#define bUSB_SERIAL_JTAG_IN_EP2_WR_ADDR sUSB_SERIAL_JTAG.inEp2StReg.BITS.IN_EPX_WR_ADDR // 2-8 (RO) Represents the write data address of IN endpoint 2
+#define bUSB_SERIAL_JTAG_IN_EP2_RD_ADDR sUSB_SERIAL_JTAG.inEp2StReg.BITS.IN_EPX_RD_ADDR // 9-15 (RO) Represents the read data address of IN endpoint 2
 /** @} */
 
 /**
  * \addtogroup USB_SERIAL_JTAG_IN_EP3_ST_REG
  * @{
- */	
-#define rUSB_SERIAL_JTAG_IN_EP3_ST sUSB_SERIAL_JTAG.inEp3StReg.WORD // Control IN endpoint status information
-#define bUSB_SERIAL_JTAG_IN_EP3_STATE sUSB_SERIAL_JTAG.inEp3StReg.BITS.IN_EP_STATE // 0-1 (RO) Represents state of IN Endpoint 2
-#define bUSB_SERIAL_JTAG_IN_EP3_WR_ADDR sUSB_SERIAL_JTAG.inEp3StReg.BITS.IN_EP_WR_ADDR // 2-8 (RO) Represents write data address of IN endpoint 2
-#define bUSB_SERIAL_JTAG_IN_EP3_RD_ADDR sUSB_SERIAL_JTAG.inEp3StReg.BITS.IN_EP_RD_ADDR // 9-15 (RO) Represents read data address of IN endpoint 2
+ */
+#define rUSB_SERIAL_JTAG_IN_EP3_ST sUSB_SERIAL_JTAG.inEp3StReg.WORD // JTAG IN endpoint status information
+#define bUSB_SERIAL_JTAG_IN_EP3_STATE sUSB_SERIAL_JTAG.inEp3StReg.BITS.IN_EPX_STATE // 0-1 (RO) Represents the state of IN endpoint 3
+#define bUSB_SERIAL_JTAG_IN_EP3_WR_ADDR sUSB_SERIAL_JTAG.inEp3StReg.BITS.IN_EPX_WR_ADDR // 2-8 (RO) Represents the write data address of IN endpoint 3
+#define bUSB_SERIAL_JTAG_IN_EP3_RD_ADDR sUSB_SERIAL_JTAG.inEp3StReg.BITS.IN_EPX_RD_ADDR // 9-15 (RO) Represents the read data address of IN endpoint 3
 /** @} */
 
 /**
@@ -990,4 +1063,564 @@ typedef struct {
 #define rUSB_SERIAL_JTAG_DATE sUSB_SERIAL_JTAG.dateReg.WORD // Date register
 /** @} */
 
+
+/********************************************************************************************************************************
+*************************************************** Register Snapshot Functions *************************************************
+*********************************************************************************************************************************/
+
+/**
+ * \addtogroup USB_SERIAL_JTAG_SNAPSHOT
+ * Whole register snapshot, commit and modify functions
+ * @{
+ *
+ * Each bUSB_SERIAL_JTAG_* bitfield macro is a separate volatile access. To read several fields of
+ * the same register, take a Snapshot (one load) into a non-volatile copy of the register union and
+ * read its BITS. To write several fields, build the value in the copy and Commit it (one store),
+ * or use Modify to clear and set masks with a single load and a single store.
+ *
+ * The EP1 FIFO register has no snapshot: reading rUSB_SERIAL_JTAG_EP1 (popUSB_SERIAL_JTAG_EP1,
+ * usbSerialJtag_hwEp1Pop) pops a byte.
+ *
+ * All the helpers, and the atomic write macros, access the registers through
+ * __usbSerialJtag_regRead and __usbSerialJtag_regWrite. With USB_SERIAL_JTAG_CFG_TRACE_ENABLE set
+ * to 1 every access is counted per register (USB_SERIAL_JTAG_ESP32-C6_TRACE.h), the r/b macros
+ * are counted per calling function. With USB_SERIAL_JTAG_CFG_SIM_ENABLE set to 1 they are served
+ * by the host register model (sim/usb_serial_jtag_sim.h).
+ */
+
+/**
+ * @brief Get a field from a register value
+ *
+ * @param word Register value
+ * @param mask mUSBSERIALJTAG_* mask of the field
+ * @return uint32_t Field value, right aligned
+ */
+static inline uint32_t usbSerialJtag_fieldGet(uint32_t word, uint32_t mask)
+{
+    return (word & mask) >> __builtin_ctz(mask);
+}
+
+/**
+ * @brief Set a field in a register value
+ *
+ * @param word Register value
+ * @param mask mUSBSERIALJTAG_* mask of the field
+ * @param value Field value, right aligned
+ * @return uint32_t Register value with the field replaced
+ */
+static inline uint32_t usbSerialJtag_fieldSet(uint32_t word, uint32_t mask, uint32_t value)
+{
+    return (word & ~mask) | ((value << __builtin_ctz(mask)) & mask);
+}
+
+/**
+ * @brief Read a register word (one APB load)
+ *
+ * @param reg Register address
+ * @return uint32_t Register value
+ */
+static inline uint32_t __usbSerialJtag_regRead(const volatile uint32_t *reg)
+{
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+    uint32_t value = usbSerialJtag_simRead(reg);
+#else
+    uint32_t value = *reg;
+#endif
+#if USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+    usbSerialJtag_traceAccess((uintptr_t) reg, value, kUSB_SERIAL_JTAG_TRACE_READ);
+#endif
+    return value;
+}
+
+/**
+ * @brief Write a register word (one APB store)
+ *
+ * @param reg Register address
+ * @param value Register value
+ */
+static inline void __usbSerialJtag_regWrite(volatile uint32_t *reg, uint32_t value)
+{
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+    usbSerialJtag_simWrite(reg, value);
+#else
+    *reg = value;
+#endif
+#if USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+    usbSerialJtag_traceAccess((uintptr_t) reg, value, kUSB_SERIAL_JTAG_TRACE_WRITE);
+#endif
+}
+
+static inline __usbSerialJtag_ep1ConfReg_t usbSerialJtag_ep1ConfSnapshot(void) // Configuration and control registers for the CDC-ACM FIFOs
+{
+    __usbSerialJtag_ep1ConfReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.ep1ConfReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_ep1ConfCommit(__usbSerialJtag_ep1ConfReg_t reg) // Configuration and control registers for the CDC-ACM FIFOs
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.ep1ConfReg.WORD, reg.WORD);
+}
+
+static inline __usbSerialJtag_intStatusReg_t usbSerialJtag_intRawSnapshot(void) // Interrupt RAW status register
+{
+    __usbSerialJtag_intStatusReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.intRawReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_intStatusReg_t usbSerialJtag_intStSnapshot(void) // Interrupt status register
+{
+    __usbSerialJtag_intStatusReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.intStReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_intStatusReg_t usbSerialJtag_intEnaSnapshot(void) // Interrupt enable register
+{
+    __usbSerialJtag_intStatusReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_intEnaCommit(__usbSerialJtag_intStatusReg_t reg) // Interrupt enable register
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_intEnaModify(uint32_t clrMask, uint32_t setMask) // Interrupt enable register
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline void usbSerialJtag_intClrCommit(__usbSerialJtag_intStatusReg_t reg) // Interrupt clear register
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.intClrReg.WORD, reg.WORD);
+}
+
+static inline __usbSerialJtag_conf0Reg_t usbSerialJtag_conf0Snapshot(void) // PHY hardware configuration
+{
+    __usbSerialJtag_conf0Reg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_conf0Commit(__usbSerialJtag_conf0Reg_t reg) // PHY hardware configuration
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_conf0Modify(uint32_t clrMask, uint32_t setMask) // PHY hardware configuration
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_testReg_t usbSerialJtag_testSnapshot(void) // Registers used for debugging the PHY
+{
+    __usbSerialJtag_testReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_testCommit(__usbSerialJtag_testReg_t reg) // Registers used for debugging the PHY
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_testModify(uint32_t clrMask, uint32_t setMask) // Registers used for debugging the PHY
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_jfifoStReg_t usbSerialJtag_jfifoStSnapshot(void) // JTAG FIFO status and control registers
+{
+    __usbSerialJtag_jfifoStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_jfifoStCommit(__usbSerialJtag_jfifoStReg_t reg) // JTAG FIFO status and control registers
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_jfifoStModify(uint32_t clrMask, uint32_t setMask) // JTAG FIFO status and control registers
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_framNumReg_t usbSerialJtag_framNumSnapshot(void) // Last received SOF frame index register
+{
+    __usbSerialJtag_framNumReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.framNumReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_inEpxStReg_t usbSerialJtag_inEp0StSnapshot(void) // Control IN endpoint status information
+{
+    __usbSerialJtag_inEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.inEp0StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_inEpxStReg_t usbSerialJtag_inEp1StSnapshot(void) // CDC-ACM IN endpoint status information
+{
+    __usbSerialJtag_inEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.inEp1StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_inEpxStReg_t usbSerialJtag_inEp2StSnapshot(void) // CDC-ACM interrupt IN endpoint status information
+{
+    __usbSerialJtag_inEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.inEp2StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_inEpxStReg_t usbSerialJtag_inEp3StSnapshot(void) // JTAG IN endpoint status information
+{
+    __usbSerialJtag_inEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.inEp3StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_outEpxStReg_t usbSerialJtag_outEp0StSnapshot(void) // Control OUT endpoint status information
+{
+    __usbSerialJtag_outEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.outEp0StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_outEpxStReg_t usbSerialJtag_outEp1StSnapshot(void) // CDC-ACM OUT endpoint status information
+{
+    __usbSerialJtag_outEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.outEp1StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_outEpxStReg_t usbSerialJtag_outEp2StSnapshot(void) // JTAG OUT endpoint status information
+{
+    __usbSerialJtag_outEpxStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.outEp2StReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_miscConfReg_t usbSerialJtag_miscConfSnapshot(void) // Clock enable control
+{
+    __usbSerialJtag_miscConfReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_miscConfCommit(__usbSerialJtag_miscConfReg_t reg) // Clock enable control
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_miscConfModify(uint32_t clrMask, uint32_t setMask) // Clock enable control
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_memConfReg_t usbSerialJtag_memConfSnapshot(void) // Memory power control
+{
+    __usbSerialJtag_memConfReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_memConfCommit(__usbSerialJtag_memConfReg_t reg) // Memory power control
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_memConfModify(uint32_t clrMask, uint32_t setMask) // Memory power control
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_chipRstReg_t usbSerialJtag_chipRstSnapshot(void) // CDC-ACM chip reset control
+{
+    __usbSerialJtag_chipRstReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_chipRstCommit(__usbSerialJtag_chipRstReg_t reg) // CDC-ACM chip reset control
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_chipRstModify(uint32_t clrMask, uint32_t setMask) // CDC-ACM chip reset control
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_setLineCodeW0Reg_t usbSerialJtag_setLineCodeW0Snapshot(void) // W0 of SET_LINE_CODING command
+{
+    __usbSerialJtag_setLineCodeW0Reg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.setLineCodeW0Reg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_setLineCodeW1Reg_t usbSerialJtag_setLineCodeW1Snapshot(void) // W1 of SET_LINE_CODING command
+{
+    __usbSerialJtag_setLineCodeW1Reg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.setLineCodeW1Reg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_getLineCodeW0Reg_t usbSerialJtag_getLineCodeW0Snapshot(void) // W0 of GET_LINE_CODING command
+{
+    __usbSerialJtag_getLineCodeW0Reg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW0Reg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_getLineCodeW0Commit(__usbSerialJtag_getLineCodeW0Reg_t reg) // W0 of GET_LINE_CODING command
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW0Reg.WORD, reg.WORD);
+}
+
+static inline __usbSerialJtag_getLineCodeW1Reg_t usbSerialJtag_getLineCodeW1Snapshot(void) // W1 of GET_LINE_CODING command
+{
+    __usbSerialJtag_getLineCodeW1Reg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_getLineCodeW1Commit(__usbSerialJtag_getLineCodeW1Reg_t reg) // W1 of GET_LINE_CODING command
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_getLineCodeW1Modify(uint32_t clrMask, uint32_t setMask) // W1 of GET_LINE_CODING command
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD) & ~clrMask) | setMask);
+}
+
+static inline void usbSerialJtag_configUpdateCommit(__usbSerialJtag_configUpdateReg_t reg) // Configuration registers’ value update
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.configUpdateReg.WORD, reg.WORD);
+}
+
+static inline __usbSerialJtag_serAfifoConficReg_t usbSerialJtag_serAfifoConficSnapshot(void) // Serial AFIFO configure register
+{
+    __usbSerialJtag_serAfifoConficReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD);
+    return reg;
+}
+static inline void usbSerialJtag_serAfifoConficCommit(__usbSerialJtag_serAfifoConficReg_t reg) // Serial AFIFO configure register
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD, reg.WORD);
+}
+static inline void usbSerialJtag_serAfifoConficModify(uint32_t clrMask, uint32_t setMask) // Serial AFIFO configure register
+{
+    __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD, (__usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD) & ~clrMask) | setMask);
+}
+
+static inline __usbSerialJtag_busResetStReg_t usbSerialJtag_busResetStSnapshot(void) // USB Bus reset status register
+{
+    __usbSerialJtag_busResetStReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.busResetStReg.WORD);
+    return reg;
+}
+
+static inline __usbSerialJtag_dateReg_t usbSerialJtag_dateSnapshot(void) // Date register
+{
+    __usbSerialJtag_dateReg_t reg;
+    reg.WORD = __usbSerialJtag_regRead(&sUSB_SERIAL_JTAG_MMIO.dateReg.WORD);
+    return reg;
+}
+
+/**
+ * \typedef __usbSerialJtag_epStatus_t
+ * Status of all the endpoints, inEp0StReg to outEp2StReg (0x0028-0x0040)
+ */
+typedef struct {
+    __usbSerialJtag_inEpxStReg_t in[4]; // inEp0StReg..inEp3StReg
+    __usbSerialJtag_outEpxStReg_t out[3]; // outEp0StReg..outEp2StReg
+    uint8_t inUsed[4]; // Bytes in the IN endpoint FIFOs, (WR_ADDR - RD_ADDR) mod 128
+    uint8_t outUsed[3]; // Bytes in the OUT endpoint FIFOs, (WR_ADDR - RD_ADDR) mod 128
+} __usbSerialJtag_epStatus_t;
+
+#ifdef __cplusplus
+static_assert(__builtin_offsetof(__usbSerialJtag_t, outEp2StReg) - __builtin_offsetof(__usbSerialJtag_t, inEp0StReg) == 6U * 4U,
+              "Endpoint status registers must be contiguous");
+#else
+_Static_assert(__builtin_offsetof(__usbSerialJtag_t, outEp2StReg) - __builtin_offsetof(__usbSerialJtag_t, inEp0StReg) == 6U * 4U,
+               "Endpoint status registers must be contiguous");
+#endif
+
+/**
+ * @brief Read the seven endpoint status registers in one burst of consecutive loads
+ *
+ * The loads are issued back to back with nothing in between, the registers are sampled within a
+ * few bus cycles of each other (they are not latched together by the hardware).
+ *
+ * @param out Register values and FIFO occupancy of every endpoint
+ */
+static inline void usbSerialJtag_epStatusSnapshot(__usbSerialJtag_epStatus_t *out)
+{
+    const volatile uint32_t *regs = &sUSB_SERIAL_JTAG_MMIO.inEp0StReg.WORD;
+    uint32_t word[7];
+
+    for (uint32_t i = 0; i < 7U; i++) {
+        word[i] = __usbSerialJtag_regRead(&regs[i]);
+    }
+
+    // Both pointers are 7 bits wide, the occupancy is computed from the same load
+    for (uint32_t i = 0; i < 4U; i++) {
+        out->in[i].WORD = word[i];
+        out->inUsed[i] = (uint8_t) ((usbSerialJtag_fieldGet(word[i], mUSBSERIALJTAG_INEPXSTREG_IN_EPX_WR_ADDR) -
+                                     usbSerialJtag_fieldGet(word[i], mUSBSERIALJTAG_INEPXSTREG_IN_EPX_RD_ADDR)) & 0x7FU);
+    }
+    for (uint32_t i = 0; i < 3U; i++) {
+        out->out[i].WORD = word[4U + i];
+        out->outUsed[i] = (uint8_t) ((usbSerialJtag_fieldGet(word[4U + i], mUSBSERIALJTAG_OUTEPXSTREG_OUT_EPX_WR_ADDR) -
+                                      usbSerialJtag_fieldGet(word[4U + i], mUSBSERIALJTAG_OUTEPXSTREG_OUT_EPX_RD_ADDR)) & 0x7FU);
+    }
+}
+/** @} */
+
+
+/********************************************************************************************************************************
+*************************************************** Register Atomic Write Macros ************************************************
+*********************************************************************************************************************************/
+
+/**
+ * \addtogroup USB_SERIAL_JTAG_ATOMIC
+ * Atomic set, clear and toggle of register bits
+ * @{
+ *
+ * setUSB_SERIAL_JTAG_x(mask), clrUSB_SERIAL_JTAG_x(mask) and xorUSB_SERIAL_JTAG_x(mask) set, clear
+ * or toggle the bits of mask in the register x without a window where an ISR can interleave its
+ * own write. They are built on the mUSBSERIALJTAG_* masks.
+ *
+ * By default the read-modify-write runs with mstatus.MIE cleared, which is atomic on the single HP
+ * core of the ESP32-C6. With USB_SERIAL_JTAG_CFG_ATOMIC_AMO set to 1 (RISC-V targets with the A
+ * extension) each macro is a single amoor.w/amoand.w/amoxor.w instead: only set it once the AMOs
+ * are known to be executed by the peripheral bus, an AMO that faults or is dropped there breaks
+ * every INT_ENA update.
+ *
+ * The WT registers (EP1_CONF, INT_CLR, CONFIG_UPDATE) only have set: writing a 0 bit has no effect,
+ * so a plain store is already atomic and must not be turned into a read-modify-write.
+ */
+
+#if USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+#define __USB_SERIAL_JTAG_TRACE_AMO(reg, mask) usbSerialJtag_traceAccess((uintptr_t) (reg), (mask), kUSB_SERIAL_JTAG_TRACE_AMO)
+#else
+#define __USB_SERIAL_JTAG_TRACE_AMO(reg, mask) ((void) 0)
+#endif
+
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE
+#define __USB_SERIAL_JTAG_SIM_AMO(reg) usbSerialJtag_simAmo(reg)
+#else
+#define __USB_SERIAL_JTAG_SIM_AMO(reg) ((void) 0)
+#endif
+
+#if USB_SERIAL_JTAG_CFG_ATOMIC_AMO && defined(__riscv_atomic)
+static inline void __usbSerialJtag_atomicOr(volatile uint32_t *reg, uint32_t mask)
+{
+    __asm__ volatile ("amoor.w zero, %1, %0" : "+A" (*reg) : "r" (mask) : "memory");
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+
+static inline void __usbSerialJtag_atomicAnd(volatile uint32_t *reg, uint32_t mask)
+{
+    __asm__ volatile ("amoand.w zero, %1, %0" : "+A" (*reg) : "r" (mask) : "memory");
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+
+static inline void __usbSerialJtag_atomicXor(volatile uint32_t *reg, uint32_t mask)
+{
+    __asm__ volatile ("amoxor.w zero, %1, %0" : "+A" (*reg) : "r" (mask) : "memory");
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+#elif defined(__riscv)
+static inline uint32_t __usbSerialJtag_irqSave(void)
+{
+    uint32_t mstatus;
+    __asm__ volatile ("csrrci %0, mstatus, 8" : "=r" (mstatus) : : "memory");
+    return mstatus;
+}
+
+static inline void __usbSerialJtag_irqRestore(uint32_t mstatus)
+{
+    __asm__ volatile ("csrs mstatus, %0" : : "r" (mstatus & 8U) : "memory");
+}
+
+static inline void __usbSerialJtag_atomicOr(volatile uint32_t *reg, uint32_t mask)
+{
+    uint32_t key = __usbSerialJtag_irqSave();
+    *reg |= mask;
+    __usbSerialJtag_irqRestore(key);
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+
+static inline void __usbSerialJtag_atomicAnd(volatile uint32_t *reg, uint32_t mask)
+{
+    uint32_t key = __usbSerialJtag_irqSave();
+    *reg &= mask;
+    __usbSerialJtag_irqRestore(key);
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+
+static inline void __usbSerialJtag_atomicXor(volatile uint32_t *reg, uint32_t mask)
+{
+    uint32_t key = __usbSerialJtag_irqSave();
+    *reg ^= mask;
+    __usbSerialJtag_irqRestore(key);
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+#else
+static inline void __usbSerialJtag_atomicOr(volatile uint32_t *reg, uint32_t mask)
+{
+    __atomic_fetch_or(reg, mask, __ATOMIC_SEQ_CST);
+    __USB_SERIAL_JTAG_SIM_AMO(reg);
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+
+static inline void __usbSerialJtag_atomicAnd(volatile uint32_t *reg, uint32_t mask)
+{
+    __atomic_fetch_and(reg, mask, __ATOMIC_SEQ_CST);
+    __USB_SERIAL_JTAG_SIM_AMO(reg);
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+
+static inline void __usbSerialJtag_atomicXor(volatile uint32_t *reg, uint32_t mask)
+{
+    __atomic_fetch_xor(reg, mask, __ATOMIC_SEQ_CST);
+    __USB_SERIAL_JTAG_SIM_AMO(reg);
+    __USB_SERIAL_JTAG_TRACE_AMO(reg, mask);
+}
+#endif
+
+#define setUSB_SERIAL_JTAG_INT_ENA(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD, (uint32_t) (mask)) // Interrupt enable register
+#define clrUSB_SERIAL_JTAG_INT_ENA(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD, ~(uint32_t) (mask)) // Interrupt enable register
+#define xorUSB_SERIAL_JTAG_INT_ENA(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.intEnaReg.WORD, (uint32_t) (mask)) // Interrupt enable register
+
+#define setUSB_SERIAL_JTAG_CONF0(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD, (uint32_t) (mask)) // PHY hardware configuration
+#define clrUSB_SERIAL_JTAG_CONF0(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD, ~(uint32_t) (mask)) // PHY hardware configuration
+#define xorUSB_SERIAL_JTAG_CONF0(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.conf0Reg.WORD, (uint32_t) (mask)) // PHY hardware configuration
+
+#define setUSB_SERIAL_JTAG_TEST(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD, (uint32_t) (mask)) // Registers used for debugging the PHY
+#define clrUSB_SERIAL_JTAG_TEST(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD, ~(uint32_t) (mask)) // Registers used for debugging the PHY
+#define xorUSB_SERIAL_JTAG_TEST(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.testReg.WORD, (uint32_t) (mask)) // Registers used for debugging the PHY
+
+#define setUSB_SERIAL_JTAG_JFIFO_ST(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD, (uint32_t) (mask)) // JTAG FIFO status and control registers
+#define clrUSB_SERIAL_JTAG_JFIFO_ST(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD, ~(uint32_t) (mask)) // JTAG FIFO status and control registers
+#define xorUSB_SERIAL_JTAG_JFIFO_ST(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.jfifoStReg.WORD, (uint32_t) (mask)) // JTAG FIFO status and control registers
+
+#define setUSB_SERIAL_JTAG_MISC_CONF(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD, (uint32_t) (mask)) // Clock enable control
+#define clrUSB_SERIAL_JTAG_MISC_CONF(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD, ~(uint32_t) (mask)) // Clock enable control
+#define xorUSB_SERIAL_JTAG_MISC_CONF(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.miscConfReg.WORD, (uint32_t) (mask)) // Clock enable control
+
+#define setUSB_SERIAL_JTAG_MEM_CONF(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD, (uint32_t) (mask)) // Memory power control
+#define clrUSB_SERIAL_JTAG_MEM_CONF(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD, ~(uint32_t) (mask)) // Memory power control
+#define xorUSB_SERIAL_JTAG_MEM_CONF(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.memConfReg.WORD, (uint32_t) (mask)) // Memory power control
+
+#define setUSB_SERIAL_JTAG_CHIP_RST(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD, (uint32_t) (mask)) // CDC-ACM chip reset control
+#define clrUSB_SERIAL_JTAG_CHIP_RST(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD, ~(uint32_t) (mask)) // CDC-ACM chip reset control
+#define xorUSB_SERIAL_JTAG_CHIP_RST(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.chipRstReg.WORD, (uint32_t) (mask)) // CDC-ACM chip reset control
+
+#define setUSB_SERIAL_JTAG_GET_LINE_CODE_W0(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW0Reg.WORD, (uint32_t) (mask)) // W0 of GET_LINE_CODING command
+#define clrUSB_SERIAL_JTAG_GET_LINE_CODE_W0(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW0Reg.WORD, ~(uint32_t) (mask)) // W0 of GET_LINE_CODING command
+#define xorUSB_SERIAL_JTAG_GET_LINE_CODE_W0(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW0Reg.WORD, (uint32_t) (mask)) // W0 of GET_LINE_CODING command
+
+#define setUSB_SERIAL_JTAG_GET_LINE_CODE_W1(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD, (uint32_t) (mask)) // W1 of GET_LINE_CODING command
+#define clrUSB_SERIAL_JTAG_GET_LINE_CODE_W1(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD, ~(uint32_t) (mask)) // W1 of GET_LINE_CODING command
+#define xorUSB_SERIAL_JTAG_GET_LINE_CODE_W1(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.getLineCodeW1Reg.WORD, (uint32_t) (mask)) // W1 of GET_LINE_CODING command
+
+#define setUSB_SERIAL_JTAG_SER_AFIFO_CONFIC(mask) __usbSerialJtag_atomicOr(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD, (uint32_t) (mask)) // Serial AFIFO configure register
+#define clrUSB_SERIAL_JTAG_SER_AFIFO_CONFIC(mask) __usbSerialJtag_atomicAnd(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD, ~(uint32_t) (mask)) // Serial AFIFO configure register
+#define xorUSB_SERIAL_JTAG_SER_AFIFO_CONFIC(mask) __usbSerialJtag_atomicXor(&sUSB_SERIAL_JTAG_MMIO.serAfifoConficReg.WORD, (uint32_t) (mask)) // Serial AFIFO configure register
+
+#define setUSB_SERIAL_JTAG_EP1_CONF(mask) __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.ep1ConfReg.WORD, (uint32_t) (mask)) // Set WR_DONE (WT), the RO bits ignore the write
+#define setUSB_SERIAL_JTAG_INT_CLR(mask) __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.intClrReg.WORD, (uint32_t) (mask)) // Clear the interrupts of the mask (WT), the other interrupts are not affected
+#define setUSB_SERIAL_JTAG_CONFIG_UPDATE(mask) __usbSerialJtag_regWrite(&sUSB_SERIAL_JTAG_MMIO.configUpdateReg.WORD, (uint32_t) (mask)) // Set CONFIG_UPDATE (WT)
+/** @} */
+
 #endif // USB_SERIAL_JTAG_ESP32_C6_LIB_H
\ No newline at end of file
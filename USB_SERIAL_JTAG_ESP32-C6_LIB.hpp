@@ -0,0 +1,499 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LIB.hpp
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Compile-time register field accessors for the ESP32-C6 USB Serial JTAG Controller (C++17)
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file wraps the registers of __usbSerialJtag_t in constexpr field descriptors. Each
+ * descriptor carries the offset of its register, its shift, its mask and its access type, the
+ * access types are taken from the register definitions of USB_SERIAL_JTAG_ESP32-C6_LIB.h:
+ *
+ * RO   ==>   Read only, cannot be written
+ * WT   ==>   Write trigger, cannot be read nor modified
+ * RW   ==>   Read and write
+ * WTC  ==>   Read, write 1 to clear (interrupt RAW), cannot be modified
+ *
+ * All the fields passed to a single write() or modify() must belong to the same register. The
+ * values are combined at compile time, so the call is one store (write) or one load and one
+ * store (modify), the same code as hand-written mask arithmetic:
+ *
+ *     using namespace usbSerialJtag;
+ *     modify(conf0::PAD_PULL_OVERRIDE(1), conf0::DP_PULLUP(1), conf0::DP_PULLDOWN(0));
+ *     write(intClr::SOF_INT(1), intClr::USB_BUS_RESET_INT(1));
+ *     uint32_t vrefh = read(conf0::VREFH);
+ *     auto ep1 = snapshot(inEp1St::REG);  // one load, several fields
+ *     uint32_t used = ep1.get(inEp1St::IN_EPX_WR_ADDR) - ep1.get(inEp1St::IN_EPX_RD_ADDR);
+ *
+ * write(ep1Conf::SERIAL_OUT_EP_DATA_AVAIL(1)) does not compile (RO field). write() stores 0 in the
+ * fields that are not listed, modify() keeps them.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_LIB_HPP
+#define USB_SERIAL_JTAG_ESP32_C6_LIB_HPP
+
+#if __cplusplus < 201703L
+#error "USB_SERIAL_JTAG_ESP32-C6_LIB.hpp requires C++17"
+#endif
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+namespace usbSerialJtag {
+
+/**
+ * Access type of a register field
+ */
+enum class Access { RO, WT, RW, WTC };
+
+template <uint32_t Offset> struct Register;
+template <uint32_t Offset, uint32_t Shift, uint32_t Width, Access A> struct Field;
+
+/**
+ * Value of a field, positioned and masked
+ */
+template <uint32_t Offset, uint32_t Shift, uint32_t Width, Access A>
+struct FieldValue {
+    uint32_t bits;
+};
+
+/**
+ * Register descriptor
+ */
+template <uint32_t Offset>
+struct Register {
+    static constexpr uint32_t offset = Offset;
+
+    static volatile uint32_t &word()
+    {
+        return *reinterpret_cast<volatile uint32_t *>(kUSB_SERIAL_JTAG_BASE_ADDR + Offset);
+    }
+};
+
+/**
+ * Field descriptor
+ */
+template <uint32_t Offset, uint32_t Shift, uint32_t Width, Access A>
+struct Field {
+    static_assert(Shift + Width <= 32, "Field out of the register");
+
+    static constexpr uint32_t offset = Offset;
+    static constexpr uint32_t shift = Shift;
+    static constexpr uint32_t mask = ((Width >= 32) ? 0xFFFFFFFFU : ((1U << Width) - 1U)) << Shift;
+    static constexpr Access access = A;
+    static constexpr bool readable = (A != Access::WT);
+    static constexpr bool writable = (A != Access::RO);
+    static constexpr bool modifiable = (A == Access::RW);
+
+    constexpr FieldValue<Offset, Shift, Width, A> operator()(uint32_t value) const
+    {
+        return FieldValue<Offset, Shift, Width, A>{ (value << Shift) & mask };
+    }
+};
+
+/**
+ * Non-volatile copy of a register, taken with a single load
+ */
+template <uint32_t Offset>
+struct Snapshot {
+    uint32_t word;
+
+    template <uint32_t S, uint32_t W, Access A>
+    constexpr uint32_t get(Field<Offset, S, W, A>) const
+    {
+        static_assert(Field<Offset, S, W, A>::readable, "Field is write only");
+        return (word & Field<Offset, S, W, A>::mask) >> S;
+    }
+};
+
+/**
+ * @brief Read a field (one load)
+ */
+template <uint32_t O, uint32_t S, uint32_t W, Access A>
+inline uint32_t read(Field<O, S, W, A>)
+{
+    static_assert(Field<O, S, W, A>::readable, "Field is write only");
+    return (__usbSerialJtag_regRead(&Register<O>::word()) & Field<O, S, W, A>::mask) >> S;
+}
+
+/**
+ * @brief Read a whole register (one load)
+ */
+template <uint32_t O>
+inline Snapshot<O> snapshot(Register<O>)
+{
+    return Snapshot<O>{ __usbSerialJtag_regRead(&Register<O>::word()) };
+}
+
+/**
+ * @brief Write fields of the same register (one store, the fields not listed are written as 0)
+ */
+template <uint32_t O, uint32_t... S, uint32_t... W, Access... A>
+inline void write(FieldValue<O, S, W, A>... values)
+{
+    static_assert(sizeof...(values) > 0, "No field to write");
+    static_assert((Field<O, S, W, A>::writable && ...), "Field is read only");
+    __usbSerialJtag_regWrite(&Register<O>::word(), (values.bits | ...));
+}
+
+/**
+ * @brief Modify fields of the same register (one load and one store, the fields not listed are kept)
+ */
+template <uint32_t O, uint32_t... S, uint32_t... W, Access... A>
+inline void modify(FieldValue<O, S, W, A>... values)
+{
+    static_assert(sizeof...(values) > 0, "No field to modify");
+    static_assert((Field<O, S, W, A>::modifiable && ...), "Field cannot be read-modify-written");
+    constexpr uint32_t mask = (Field<O, S, W, A>::mask | ...);
+    volatile uint32_t &reg = Register<O>::word();
+    __usbSerialJtag_regWrite(&reg, (__usbSerialJtag_regRead(&reg) & ~mask) | (values.bits | ...));
+}
+
+/**
+ * FIFO access for the CDC-ACM data IN and OUT endpoints (0x0)
+ */
+namespace ep1 {
+constexpr Register<0x0000> REG{};
+constexpr Field<0x0000, 0, 8, Access::RW> RDWR_BYTE{}; // Write or read byte data to or from UART TX/RX FIFO
+} // namespace ep1
+
+/**
+ * Configuration and control registers for the CDC-ACM FIFOs (0x4)
+ */
+namespace ep1Conf {
+constexpr Register<0x0004> REG{};
+constexpr Field<0x0004, 0, 1, Access::WT> WR_DONE{}; // Configures whether to represent writing byte data to UART TX FIFO is done
+constexpr Field<0x0004, 1, 1, Access::RO> SERIAL_IN_EP_DATA_FREE{}; // Represents whether UART TX FIFO has space available
+constexpr Field<0x0004, 2, 1, Access::RO> SERIAL_OUT_EP_DATA_AVAIL{}; // Represents whether there is data in UART RX FIFO
+} // namespace ep1Conf
+
+/**
+ * Interrupt RAW status register (0x8)
+ */
+namespace intRaw {
+constexpr Register<0x0008> REG{};
+constexpr Field<0x0008, 0, 1, Access::WTC> IN_FLUSH_INT{}; // Interrupt status of JTAG_IN_FLUSH_INT
+constexpr Field<0x0008, 1, 1, Access::WTC> SOF_INT{}; // Interrupt status of SOF_INT
+constexpr Field<0x0008, 2, 1, Access::WTC> OUT_RECV_PKT_INT{}; // Interrupt status of OUT_RECV_PKT_INT
+constexpr Field<0x0008, 3, 1, Access::WTC> IN_EMPTY_INT{}; // Interrupt status of IN_EMPTY_INT
+constexpr Field<0x0008, 4, 1, Access::WTC> PID_ERR_INT{}; // Interrupt status of PID_ERR_INT
+constexpr Field<0x0008, 5, 1, Access::WTC> CRC5_ERR_INT{}; // Interrupt status of CRC5_ERR_INT
+constexpr Field<0x0008, 6, 1, Access::WTC> CRC16_ERR_INT{}; // Interrupt status of CRC16_ERR_INT
+constexpr Field<0x0008, 7, 1, Access::WTC> STUFF_ERR_INT{}; // Interrupt status of STUFF_ERR_INT
+constexpr Field<0x0008, 8, 1, Access::WTC> IN_TOKEN_REC_IN_EP1_INT{}; // Interrupt status of IN_TOKEN_REC_IN_EP1_INT
+constexpr Field<0x0008, 9, 1, Access::WTC> USB_BUS_RESET_INT{}; // Interrupt status of USB_BUS_RESET_INT
+constexpr Field<0x0008, 10, 1, Access::WTC> OUT_EP1_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP1_ZERO_PAYLOAD_INT
+constexpr Field<0x0008, 11, 1, Access::WTC> OUT_EP2_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP2_ZERO_PAYLOAD_INT
+constexpr Field<0x0008, 12, 1, Access::WTC> RTS_CHG_INT{}; // Interrupt status of RTS_CHG_INT
+constexpr Field<0x0008, 13, 1, Access::WTC> DTR_CHG_INT{}; // Interrupt status of DTR_CHG_INT
+constexpr Field<0x0008, 14, 1, Access::WTC> GET_LINE_CODE_INT{}; // Interrupt status of GET_LINE_CODE_INT
+constexpr Field<0x0008, 15, 1, Access::WTC> SET_LINE_CODE_INT{}; // Interrupt status of SET_LINE_CODE_INT
+} // namespace intRaw
+
+/**
+ * Interrupt status register (0xC)
+ */
+namespace intSt {
+constexpr Register<0x000C> REG{};
+constexpr Field<0x000C, 0, 1, Access::RO> IN_FLUSH_INT{}; // Interrupt status of JTAG_IN_FLUSH_INT
+constexpr Field<0x000C, 1, 1, Access::RO> SOF_INT{}; // Interrupt status of SOF_INT
+constexpr Field<0x000C, 2, 1, Access::RO> OUT_RECV_PKT_INT{}; // Interrupt status of OUT_RECV_PKT_INT
+constexpr Field<0x000C, 3, 1, Access::RO> IN_EMPTY_INT{}; // Interrupt status of IN_EMPTY_INT
+constexpr Field<0x000C, 4, 1, Access::RO> PID_ERR_INT{}; // Interrupt status of PID_ERR_INT
+constexpr Field<0x000C, 5, 1, Access::RO> CRC5_ERR_INT{}; // Interrupt status of CRC5_ERR_INT
+constexpr Field<0x000C, 6, 1, Access::RO> CRC16_ERR_INT{}; // Interrupt status of CRC16_ERR_INT
+constexpr Field<0x000C, 7, 1, Access::RO> STUFF_ERR_INT{}; // Interrupt status of STUFF_ERR_INT
+constexpr Field<0x000C, 8, 1, Access::RO> IN_TOKEN_REC_IN_EP1_INT{}; // Interrupt status of IN_TOKEN_REC_IN_EP1_INT
+constexpr Field<0x000C, 9, 1, Access::RO> USB_BUS_RESET_INT{}; // Interrupt status of USB_BUS_RESET_INT
+constexpr Field<0x000C, 10, 1, Access::RO> OUT_EP1_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP1_ZERO_PAYLOAD_INT
+constexpr Field<0x000C, 11, 1, Access::RO> OUT_EP2_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP2_ZERO_PAYLOAD_INT
+constexpr Field<0x000C, 12, 1, Access::RO> RTS_CHG_INT{}; // Interrupt status of RTS_CHG_INT
+constexpr Field<0x000C, 13, 1, Access::RO> DTR_CHG_INT{}; // Interrupt status of DTR_CHG_INT
+constexpr Field<0x000C, 14, 1, Access::RO> GET_LINE_CODE_INT{}; // Interrupt status of GET_LINE_CODE_INT
+constexpr Field<0x000C, 15, 1, Access::RO> SET_LINE_CODE_INT{}; // Interrupt status of SET_LINE_CODE_INT
+} // namespace intSt
+
+/**
+ * Interrupt enable register (0x10)
+ */
+namespace intEna {
+constexpr Register<0x0010> REG{};
+constexpr Field<0x0010, 0, 1, Access::RW> IN_FLUSH_INT{}; // Interrupt status of JTAG_IN_FLUSH_INT
+constexpr Field<0x0010, 1, 1, Access::RW> SOF_INT{}; // Interrupt status of SOF_INT
+constexpr Field<0x0010, 2, 1, Access::RW> OUT_RECV_PKT_INT{}; // Interrupt status of OUT_RECV_PKT_INT
+constexpr Field<0x0010, 3, 1, Access::RW> IN_EMPTY_INT{}; // Interrupt status of IN_EMPTY_INT
+constexpr Field<0x0010, 4, 1, Access::RW> PID_ERR_INT{}; // Interrupt status of PID_ERR_INT
+constexpr Field<0x0010, 5, 1, Access::RW> CRC5_ERR_INT{}; // Interrupt status of CRC5_ERR_INT
+constexpr Field<0x0010, 6, 1, Access::RW> CRC16_ERR_INT{}; // Interrupt status of CRC16_ERR_INT
+constexpr Field<0x0010, 7, 1, Access::RW> STUFF_ERR_INT{}; // Interrupt status of STUFF_ERR_INT
+constexpr Field<0x0010, 8, 1, Access::RW> IN_TOKEN_REC_IN_EP1_INT{}; // Interrupt status of IN_TOKEN_REC_IN_EP1_INT
+constexpr Field<0x0010, 9, 1, Access::RW> USB_BUS_RESET_INT{}; // Interrupt status of USB_BUS_RESET_INT
+constexpr Field<0x0010, 10, 1, Access::RW> OUT_EP1_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP1_ZERO_PAYLOAD_INT
+constexpr Field<0x0010, 11, 1, Access::RW> OUT_EP2_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP2_ZERO_PAYLOAD_INT
+constexpr Field<0x0010, 12, 1, Access::RW> RTS_CHG_INT{}; // Interrupt status of RTS_CHG_INT
+constexpr Field<0x0010, 13, 1, Access::RW> DTR_CHG_INT{}; // Interrupt status of DTR_CHG_INT
+constexpr Field<0x0010, 14, 1, Access::RW> GET_LINE_CODE_INT{}; // Interrupt status of GET_LINE_CODE_INT
+constexpr Field<0x0010, 15, 1, Access::RW> SET_LINE_CODE_INT{}; // Interrupt status of SET_LINE_CODE_INT
+} // namespace intEna
+
+/**
+ * Interrupt clear register (0x14)
+ */
+namespace intClr {
+constexpr Register<0x0014> REG{};
+constexpr Field<0x0014, 0, 1, Access::WT> IN_FLUSH_INT{}; // Interrupt status of JTAG_IN_FLUSH_INT
+constexpr Field<0x0014, 1, 1, Access::WT> SOF_INT{}; // Interrupt status of SOF_INT
+constexpr Field<0x0014, 2, 1, Access::WT> OUT_RECV_PKT_INT{}; // Interrupt status of OUT_RECV_PKT_INT
+constexpr Field<0x0014, 3, 1, Access::WT> IN_EMPTY_INT{}; // Interrupt status of IN_EMPTY_INT
+constexpr Field<0x0014, 4, 1, Access::WT> PID_ERR_INT{}; // Interrupt status of PID_ERR_INT
+constexpr Field<0x0014, 5, 1, Access::WT> CRC5_ERR_INT{}; // Interrupt status of CRC5_ERR_INT
+constexpr Field<0x0014, 6, 1, Access::WT> CRC16_ERR_INT{}; // Interrupt status of CRC16_ERR_INT
+constexpr Field<0x0014, 7, 1, Access::WT> STUFF_ERR_INT{}; // Interrupt status of STUFF_ERR_INT
+constexpr Field<0x0014, 8, 1, Access::WT> IN_TOKEN_REC_IN_EP1_INT{}; // Interrupt status of IN_TOKEN_REC_IN_EP1_INT
+constexpr Field<0x0014, 9, 1, Access::WT> USB_BUS_RESET_INT{}; // Interrupt status of USB_BUS_RESET_INT
+constexpr Field<0x0014, 10, 1, Access::WT> OUT_EP1_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP1_ZERO_PAYLOAD_INT
+constexpr Field<0x0014, 11, 1, Access::WT> OUT_EP2_ZERO_PAYLOAD_INT{}; // Interrupt status of OUT_EP2_ZERO_PAYLOAD_INT
+constexpr Field<0x0014, 12, 1, Access::WT> RTS_CHG_INT{}; // Interrupt status of RTS_CHG_INT
+constexpr Field<0x0014, 13, 1, Access::WT> DTR_CHG_INT{}; // Interrupt status of DTR_CHG_INT
+constexpr Field<0x0014, 14, 1, Access::WT> GET_LINE_CODE_INT{}; // Interrupt status of GET_LINE_CODE_INT
+constexpr Field<0x0014, 15, 1, Access::WT> SET_LINE_CODE_INT{}; // Interrupt status of SET_LINE_CODE_INT
+} // namespace intClr
+
+/**
+ * PHY hardware configuration (0x18)
+ */
+namespace conf0 {
+constexpr Register<0x0018> REG{};
+constexpr Field<0x0018, 0, 1, Access::RW> PHY_SEL{}; // Configures whether to select internal or external PHY
+constexpr Field<0x0018, 1, 1, Access::RW> EXCHG_PINS_OVERRIDE{}; // Configures whether to enable software control USB D+ D- exchange
+constexpr Field<0x0018, 2, 1, Access::RW> EXCHG_PINS{}; // Configures whether to enable USB D+ D- exchange
+constexpr Field<0x0018, 3, 2, Access::RW> VREFH{}; // Configures single-end input high threshold
+constexpr Field<0x0018, 5, 2, Access::RW> VREFL{}; // Configures single-end input low threshold
+constexpr Field<0x0018, 7, 1, Access::RW> VREF_OVERRIDE{}; // Configures whether to enable software control input thresh-old
+constexpr Field<0x0018, 8, 1, Access::RW> PAD_PULL_OVERRIDE{}; // Configures whether to enable software to control USB D+ D- pullup and pulldown
+constexpr Field<0x0018, 9, 1, Access::RW> DP_PULLUP{}; // Configures whether to enable USB D+ pull up when PAD_PULL_OVERRIDE is 1
+constexpr Field<0x0018, 10, 1, Access::RW> DP_PULLDOWN{}; // Configures whether to enable USB D+ pull down when PAD_PULL_OVERRIDE is 1
+constexpr Field<0x0018, 11, 1, Access::RW> DM_PULLUP{}; // Configures whether to enable USB D- pull up when PAD_PULL_OVERRIDE is 1
+constexpr Field<0x0018, 12, 1, Access::RW> DM_PULLDOWN{}; // Configures whether to enable USB D- pull down when PAD_PULL_OVERRIDE is 1
+constexpr Field<0x0018, 13, 1, Access::RW> PULLUP_VALUE{}; // Configures the pull up value when PAD_PULL_OVERRIDE is 1
+constexpr Field<0x0018, 14, 1, Access::RW> USB_PAD_ENABLE{}; // Configures whether to enable USB pad function
+constexpr Field<0x0018, 15, 1, Access::RW> USB_JTAG_BRIDGE_EN{}; // Configures whether to disconnect usb_jtag and in-ternal JTAG
+} // namespace conf0
+
+/**
+ * Registers used for debugging the PHY (0x1C)
+ */
+namespace test {
+constexpr Register<0x001C> REG{};
+constexpr Field<0x001C, 0, 1, Access::RW> TEST_ENABLE{}; // Configures whether to enable the test mode of the USB pad
+constexpr Field<0x001C, 1, 1, Access::RW> TEST_USB_OE{}; // Configures whether to enable USB pad output
+constexpr Field<0x001C, 2, 1, Access::RW> TEST_TX_DP{}; // Configures value of USB D+ in test mode when TEST_USB_OE is 1
+constexpr Field<0x001C, 3, 1, Access::RW> TEST_TX_DM{}; // Configures value of USB D- in test mode when TEST_USB_OE is 1
+constexpr Field<0x001C, 4, 1, Access::RO> TEST_RX_RCV{}; // Represents the current logical level of the voltage difference between USB D- and USB D+ pads in test mode
+constexpr Field<0x001C, 5, 1, Access::RO> TEST_RX_DP{}; // Represents the logical level of the USB D+ pad in test mode
+constexpr Field<0x001C, 6, 1, Access::RO> TEST_RX_DM{}; // Represents the logical level of the USB D- pad in test mode
+} // namespace test
+
+/**
+ * JTAG FIFO status and control registers (0x20)
+ */
+namespace jfifoSt {
+constexpr Register<0x0020> REG{};
+constexpr Field<0x0020, 0, 2, Access::RO> IN_FIFO_CNT{}; // Represents JTAG IN FIFO counter
+constexpr Field<0x0020, 2, 1, Access::RO> IN_FIFO_EMPTY{}; // Represents whether JTAG IN FIFO is empty
+constexpr Field<0x0020, 3, 1, Access::RO> IN_FIFO_FULL{}; // Represents whether JTAG IN FIFO is full
+constexpr Field<0x0020, 4, 2, Access::RO> OUT_FIFO_CNT{}; // Represents JTAG OUT FIFO counter
+constexpr Field<0x0020, 6, 1, Access::RO> OUT_FIFO_EMPTY{}; // Represents whether JTAG OUT FIFO is empty
+constexpr Field<0x0020, 7, 1, Access::RO> OUT_FIFO_FULL{}; // Represents whether JTAG OUT FIFO is full
+constexpr Field<0x0020, 8, 1, Access::RW> IN_FIFO_RESET{}; // Configures whether to reset JTAG IN FIFO
+constexpr Field<0x0020, 9, 1, Access::RW> OUT_FIFO_RESET{}; // Configures whether to reset JTAG OUT FIFO
+} // namespace jfifoSt
+
+/**
+ * Last received SOF frame index register (0x24)
+ */
+namespace framNum {
+constexpr Register<0x0024> REG{};
+constexpr Field<0x0024, 0, 11, Access::RO> SOF_FRAME_INDEX{}; // Represents frame index of received SOF frame
+} // namespace framNum
+
+/**
+ * Control IN endpoint status information (0x28)
+ */
+namespace inEp0St {
+constexpr Register<0x0028> REG{};
+constexpr Field<0x0028, 0, 2, Access::RO> IN_EPX_STATE{}; // Represents the state of IN endpoint X
+constexpr Field<0x0028, 2, 7, Access::RO> IN_EPX_WR_ADDR{}; // Represents write data address of IN endpoint X
+constexpr Field<0x0028, 9, 7, Access::RO> IN_EPX_RD_ADDR{}; // Represents read data address of IN endpoint X
+} // namespace inEp0St
+
+/**
+ * CDC-ACM IN endpoint status information (0x2C)
+ */
+namespace inEp1St {
+constexpr Register<0x002C> REG{};
+constexpr Field<0x002C, 0, 2, Access::RO> IN_EPX_STATE{}; // Represents the state of IN endpoint X
+constexpr Field<0x002C, 2, 7, Access::RO> IN_EPX_WR_ADDR{}; // Represents write data address of IN endpoint X
+constexpr Field<0x002C, 9, 7, Access::RO> IN_EPX_RD_ADDR{}; // Represents read data address of IN endpoint X
+} // namespace inEp1St
+
+/**
+ * CDC-ACM interrupt IN endpoint status information (0x30)
+ */
+namespace inEp2St {
+constexpr Register<0x0030> REG{};
+constexpr Field<0x0030, 0, 2, Access::RO> IN_EPX_STATE{}; // Represents the state of IN endpoint X
+constexpr Field<0x0030, 2, 7, Access::RO> IN_EPX_WR_ADDR{}; // Represents write data address of IN endpoint X
+constexpr Field<0x0030, 9, 7, Access::RO> IN_EPX_RD_ADDR{}; // Represents read data address of IN endpoint X
+} // namespace inEp2St
+
+/**
+ * JTAG IN endpoint status information (0x34)
+ */
+namespace inEp3St {
+constexpr Register<0x0034> REG{};
+constexpr Field<0x0034, 0, 2, Access::RO> IN_EPX_STATE{}; // Represents the state of IN endpoint X
+constexpr Field<0x0034, 2, 7, Access::RO> IN_EPX_WR_ADDR{}; // Represents write data address of IN endpoint X
+constexpr Field<0x0034, 9, 7, Access::RO> IN_EPX_RD_ADDR{}; // Represents read data address of IN endpoint X
+} // namespace inEp3St
+
+/**
+ * Control OUT endpoint status information (0x38)
+ */
+namespace outEp0St {
+constexpr Register<0x0038> REG{};
+constexpr Field<0x0038, 0, 2, Access::RO> OUT_EPX_STATE{}; // Represents the state of OUT endpoint X
+constexpr Field<0x0038, 2, 7, Access::RO> OUT_EPX_WR_ADDR{}; // Represents write data address of OUT endpoint X
+constexpr Field<0x0038, 9, 7, Access::RO> OUT_EPX_RD_ADDR{}; // Represents read data address of OUT endpoint X
+constexpr Field<0x0038, 16, 7, Access::RO> EP1_REC_DATA_CNT{}; // Represents data count in OUT endpoint 1 when one packet is received
+} // namespace outEp0St
+
+/**
+ * CDC-ACM OUT endpoint status information (0x3C)
+ */
+namespace outEp1St {
+constexpr Register<0x003C> REG{};
+constexpr Field<0x003C, 0, 2, Access::RO> OUT_EPX_STATE{}; // Represents the state of OUT endpoint X
+constexpr Field<0x003C, 2, 7, Access::RO> OUT_EPX_WR_ADDR{}; // Represents write data address of OUT endpoint X
+constexpr Field<0x003C, 9, 7, Access::RO> OUT_EPX_RD_ADDR{}; // Represents read data address of OUT endpoint X
+constexpr Field<0x003C, 16, 7, Access::RO> EP1_REC_DATA_CNT{}; // Represents data count in OUT endpoint 1 when one packet is received
+} // namespace outEp1St
+
+/**
+ * JTAG OUT endpoint status information (0x40)
+ */
+namespace outEp2St {
+constexpr Register<0x0040> REG{};
+constexpr Field<0x0040, 0, 2, Access::RO> OUT_EPX_STATE{}; // Represents the state of OUT endpoint X
+constexpr Field<0x0040, 2, 7, Access::RO> OUT_EPX_WR_ADDR{}; // Represents write data address of OUT endpoint X
+constexpr Field<0x0040, 9, 7, Access::RO> OUT_EPX_RD_ADDR{}; // Represents read data address of OUT endpoint X
+constexpr Field<0x0040, 16, 7, Access::RO> EP1_REC_DATA_CNT{}; // Represents data count in OUT endpoint 1 when one packet is received
+} // namespace outEp2St
+
+/**
+ * Clock enable control (0x44)
+ */
+namespace miscConf {
+constexpr Register<0x0044> REG{};
+constexpr Field<0x0044, 0, 1, Access::RW> CLK_EN{}; // Configures whether to force clock on for register
+} // namespace miscConf
+
+/**
+ * Memory power control (0x48)
+ */
+namespace memConf {
+constexpr Register<0x0048> REG{};
+constexpr Field<0x0048, 0, 1, Access::RW> USB_MEM_PD{}; // Configures whether to power down USB memory
+constexpr Field<0x0048, 1, 1, Access::RW> USB_MEM_CLK_EN{}; // Configures whether to force clock on for USB memory
+} // namespace memConf
+
+/**
+ * CDC-ACM chip reset control (0x4C)
+ */
+namespace chipRst {
+constexpr Register<0x004C> REG{};
+constexpr Field<0x004C, 0, 1, Access::RO> JTAG_RTS{}; // Represents the state of RTS signal as set by the most recent SET_LINE_CODING command
+constexpr Field<0x004C, 1, 1, Access::RO> JTAG_DTR{}; // Represents the state of DTR signal as set by the most recent SET_LINE_CODING command
+constexpr Field<0x004C, 2, 1, Access::RW> USB_UART_CHIP_RST_DIS{}; // Configures whether to disable chip reset from USB serial channel
+} // namespace chipRst
+
+/**
+ * W0 of SET_LINE_CODING command (0x50)
+ */
+namespace setLineCodeW0 {
+constexpr Register<0x0050> REG{};
+constexpr Field<0x0050, 0, 32, Access::RO> DW_DTE_RATE{}; // Represents the value of dwDTERate set by host through SET_LINE_CODING command
+} // namespace setLineCodeW0
+
+/**
+ * W1 of SET_LINE_CODING command (0x54)
+ */
+namespace setLineCodeW1 {
+constexpr Register<0x0054> REG{};
+constexpr Field<0x0054, 0, 8, Access::RO> BCHAR_FORMAT{}; // Represents the value of bCharFormat set by host through SET_LINE_CODING command
+constexpr Field<0x0054, 8, 8, Access::RO> BPARITY_TYPE{}; // Represents the value of bParityType set by host through SET_LINE_CODING command
+constexpr Field<0x0054, 16, 8, Access::RO> BDATA_BITS{}; // Represents the value of bDataBits set by host through SET_LINE_CODING command
+} // namespace setLineCodeW1
+
+/**
+ * W0 of GET_LINE_CODING command (0x58)
+ */
+namespace getLineCodeW0 {
+constexpr Register<0x0058> REG{};
+constexpr Field<0x0058, 0, 32, Access::RW> GET_LINE_CODE_W0_REG{}; // Configures the value of dwDTERate set by software, which is requested by GET_LINE_CODING command
+} // namespace getLineCodeW0
+
+/**
+ * W1 of GET_LINE_CODING command (0x5C)
+ */
+namespace getLineCodeW1 {
+constexpr Register<0x005C> REG{};
+constexpr Field<0x005C, 0, 8, Access::RW> GET_BDATA_BITS{}; // Configures the value of bDataBits set by software, which is requested by GET_LINE_CODING command
+constexpr Field<0x005C, 8, 8, Access::RW> GET_BPARITY_TYPE{}; // Configures the value of bParityType set by software, which is requested by GET_LINE_CODING command
+constexpr Field<0x005C, 16, 8, Access::RW> GET_BCHAR_FORMAT{}; // Configures the value of bCharFormat set by software, which is requested by GET_LINE_CODING command
+} // namespace getLineCodeW1
+
+/**
+ * Configuration registers’ value update (0x60)
+ */
+namespace configUpdate {
+constexpr Register<0x0060> REG{};
+constexpr Field<0x0060, 0, 1, Access::WT> CONFIG_UPDATE{}; // Configures whether to update the value of configuration registers from APB clock domain to 48 MHz clock domain
+} // namespace configUpdate
+
+/**
+ * Serial AFIFO configure register (0x64)
+ */
+namespace serAfifoConfic {
+constexpr Register<0x0064> REG{};
+constexpr Field<0x0064, 0, 1, Access::RW> SERIAL_IN_AFIFO_RESET_WR{}; // Configures whether to reset CDC_ACM IN async FIFO write clock domain
+constexpr Field<0x0064, 1, 1, Access::RW> SERIAL_IN_AFIFO_RESET_RD{}; // Configures whether to reset CDC_ACM IN async FIFO read clock domain
+constexpr Field<0x0064, 2, 1, Access::RW> SERIAL_OUT_AFIFO_RESET_WR{}; // Configures whether to reset CDC_ACM OUT async FIFO write clock domain
+constexpr Field<0x0064, 3, 1, Access::RW> SERIAL_OUT_AFIFO_RESET_RD{}; // Configures whether to reset CDC_ACM OUT async FIFO read clock domain
+constexpr Field<0x0064, 4, 1, Access::RO> SERIAL_OUT_AFIFO_REMPTY{}; // Represents CDC_ACM OUT async FIFO empty signal in read clock domain
+constexpr Field<0x0064, 5, 1, Access::RO> SERIAL_IN_AFIFO_WFULL{}; // Represents CDC_ACM IN async FIFO full signal in write clock domain
+} // namespace serAfifoConfic
+
+/**
+ * USB Bus reset status register (0x68)
+ */
+namespace busResetSt {
+constexpr Register<0x0068> REG{};
+constexpr Field<0x0068, 0, 1, Access::RO> BUS_RESET_ST{}; // Represents whether USB bus reset is released
+} // namespace busResetSt
+
+/**
+ * Date register (0x80)
+ */
+namespace date {
+constexpr Register<0x0080> REG{};
+constexpr Field<0x0080, 0, 32, Access::RO> DATE{}; // Version control register
+} // namespace date
+
+} // namespace usbSerialJtag
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_LIB_HPP
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LINE.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief CDC-ACM line state notifications of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include <stddef.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LINE.h"
+
+_Static_assert(!USB_SERIAL_JTAG_CFG_LINE_ENABLE || kUSB_SERIAL_JTAG_HAS_LINE_REGS, "Line state events require the CDC-ACM line registers (ESP32-C6/H2)");
+
+static __usbSerialJtag_lineCb_t lineCb = NULL;
+static void *lineArg = NULL;
+static uint32_t txPaused = 0; // Written by the ISR
+
+
+/**
+ * @brief Latch the TX pause state from the DTR line
+ */
+static void lineLatch(uint32_t dtr)
+{
+#if USB_SERIAL_JTAG_CFG_LINE_TX_PAUSE
+    __atomic_store_n(&txPaused, dtr ? 0U : 1U, __ATOMIC_RELEASE);
+#else
+    (void) dtr;
+#endif
+}
+
+
+void usbSerialJtag_lineGet(__usbSerialJtag_lineCoding_t *out)
+{
+    uint32_t w1 = usbSerialJtag_setLineCodeW1Snapshot().WORD;
+    uint32_t rst = usbSerialJtag_chipRstSnapshot().WORD;
+
+    out->dwDTERate = usbSerialJtag_setLineCodeW0Snapshot().WORD;
+    out->bCharFormat = (uint8_t) usbSerialJtag_fieldGet(w1, mUSBSERIALJTAG_SETLINECODEW1REG_BCHAR_FORMAT);
+    out->bParityType = (uint8_t) usbSerialJtag_fieldGet(w1, mUSBSERIALJTAG_SETLINECODEW1REG_BPARITY_TYPE);
+    out->bDataBits = (uint8_t) usbSerialJtag_fieldGet(w1, mUSBSERIALJTAG_SETLINECODEW1REG_BDATA_BITS);
+    out->dtr = (uint8_t) usbSerialJtag_fieldGet(rst, mUSBSERIALJTAG_CHIPRSTREG_JTAG_DTR);
+    out->rts = (uint8_t) usbSerialJtag_fieldGet(rst, mUSBSERIALJTAG_CHIPRSTREG_JTAG_RTS);
+}
+
+void usbSerialJtag_lineSetCallback(__usbSerialJtag_lineCb_t cb, void *arg)
+{
+    // Remove the callback first, so the ISR never calls cb with the previous argument
+    __atomic_store_n(&lineCb, NULL, __ATOMIC_RELEASE);
+    lineArg = arg;
+    __atomic_store_n(&lineCb, cb, __ATOMIC_RELEASE);
+}
+
+uint32_t usbSerialJtag_lineTxPaused(void)
+{
+    return __atomic_load_n(&txPaused, __ATOMIC_ACQUIRE);
+}
+
+void usbSerialJtag_lineInit(void)
+{
+    lineLatch(usbSerialJtag_chipRstSnapshot().BITS.JTAG_DTR);
+}
+
+uint32_t usbSerialJtag_lineOnEvents(uint32_t events)
+{
+    __usbSerialJtag_lineCoding_t line;
+    __usbSerialJtag_lineCb_t cb = __atomic_load_n(&lineCb, __ATOMIC_ACQUIRE);
+    uint32_t wasPaused = txPaused;
+
+    usbSerialJtag_lineGet(&line);
+    lineLatch(line.dtr);
+    if (cb != NULL) {
+        cb(events, &line, lineArg);
+    }
+
+    return (wasPaused && !txPaused) ? 1U : 0U;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LINE.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief CDC-ACM line state notifications of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the line state events of the CDC-ACM channel. The interrupt driver
+ * serves RTS_CHG_INT, DTR_CHG_INT, SET_LINE_CODE_INT and GET_LINE_CODE_INT and calls the
+ * registered callback with the decoded line coding (setLineCodeW0Reg/W1Reg) and the DTR/RTS state
+ * (chipRstReg), so the application does not poll the registers to detect the port being opened.
+ *
+ * With USB_SERIAL_JTAG_CFG_LINE_TX_PAUSE the ISR does not fill the IN FIFO while DTR is low (no host
+ * application has the port open), the pending data is sent when DTR goes high.
+ *
+ * The events are served when USB_SERIAL_JTAG_CFG_LINE_ENABLE is 1.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_LINE_H
+#define USB_SERIAL_JTAG_ESP32_C6_LINE_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Interrupt sources of the line state events (bit mask passed to the callback)
+ */
+#define mUSB_SERIAL_JTAG_LINE_EVENTS (mUSBSERIALJTAG_INTSTATUSREG_RTS_CHG_INT | mUSBSERIALJTAG_INTSTATUSREG_DTR_CHG_INT | \
+                                      mUSBSERIALJTAG_INTSTATUSREG_SET_LINE_CODE_INT | mUSBSERIALJTAG_INTSTATUSREG_GET_LINE_CODE_INT)
+
+/**
+ * \typedef __usbSerialJtag_lineCoding_t
+ * Decoded CDC-ACM line coding and control lines
+ */
+typedef struct {
+    uint32_t dwDTERate; // Baud rate set by the host
+    uint8_t bCharFormat; // Stop bits: 0 = 1, 1 = 1.5, 2 = 2
+    uint8_t bParityType; // Parity: 0 = none, 1 = odd, 2 = even, 3 = mark, 4 = space
+    uint8_t bDataBits; // Data bits: 5, 6, 7, 8 or 16
+    uint8_t dtr; // DTR state (1 = port opened by the host)
+    uint8_t rts; // RTS state
+} __usbSerialJtag_lineCoding_t;
+
+/**
+ * @brief Line state callback, called from the ISR
+ *
+ * @param events mUSB_SERIAL_JTAG_LINE_EVENTS bits that fired
+ * @param line Decoded line coding and control lines
+ * @param arg Argument given at registration
+ */
+typedef void (*__usbSerialJtag_lineCb_t)(uint32_t events, const __usbSerialJtag_lineCoding_t *line, void *arg);
+
+
+/**
+ * @brief Read and decode the line coding and the control lines
+ *
+ * @param out Decoded line state
+ */
+void usbSerialJtag_lineGet(__usbSerialJtag_lineCoding_t *out);
+
+/**
+ * @brief Set the line state callback
+ *
+ * @param cb Callback (NULL to remove it)
+ * @param arg Argument of the callback
+ */
+void usbSerialJtag_lineSetCallback(__usbSerialJtag_lineCb_t cb, void *arg);
+
+/**
+ * @brief Whether the ISR holds the TX data back (DTR low and USB_SERIAL_JTAG_CFG_LINE_TX_PAUSE)
+ *
+ * @return uint32_t 1 if TX is paused
+ */
+uint32_t usbSerialJtag_lineTxPaused(void);
+
+/**
+ * @brief Latch the control lines, called by usbSerialJtag_isrInit
+ */
+void usbSerialJtag_lineInit(void);
+
+/**
+ * @brief Serve the line state events (ISR side)
+ *
+ * @param events mUSB_SERIAL_JTAG_LINE_EVENTS bits of intStReg
+ * @return uint32_t 1 if TX was resumed by the events
+ */
+uint32_t usbSerialJtag_lineOnEvents(uint32_t events);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_LINE_H
\ No newline at end of file
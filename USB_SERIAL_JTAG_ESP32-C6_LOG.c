@@ -0,0 +1,198 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LOG.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Multi-producer logging front end for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * Every record is a 32-bit header followed by the payload padded to a word. The header holds the
+ * payload length, the COMMIT bit set by the producer and the PAD bit of the filler record that
+ * skips the end of the storage, so a record is never split by the wrap of the ring.
+ *
+ * The producers reserve space by moving the head with a compare-and-swap, the ISR consumes the
+ * committed records at the tail and zeroes their words before releasing them: a word of free
+ * space always reads as an uncommitted header.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_LOG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+
+_Static_assert((USB_SERIAL_JTAG_CFG_LOG_RING_SIZE & (USB_SERIAL_JTAG_CFG_LOG_RING_SIZE - 1U)) == 0, "Log ring size must be a power of two");
+_Static_assert(USB_SERIAL_JTAG_CFG_LOG_RING_SIZE >= 16U, "Log ring size must be at least 16 bytes");
+
+#define mLOG_HDR_LEN 0x0000FFFFUL // Payload length
+#define mLOG_HDR_PAD 0x40000000UL // Filler record up to the end of the storage
+#define mLOG_HDR_COMMIT 0x80000000UL // Record committed by its producer
+#define kLOG_MASK (USB_SERIAL_JTAG_CFG_LOG_RING_SIZE - 1U)
+
+static uint32_t storage[USB_SERIAL_JTAG_CFG_LOG_RING_SIZE / 4U];
+static uint32_t head = 0; // Reserved by the producers (CAS)
+static uint32_t tail = 0; // Written by the ISR
+static uint32_t recOff = 0; // Payload bytes of the record at the tail already pushed (ISR only)
+static uint32_t dropped = 0;
+
+
+static inline uint32_t *logWord(uint32_t pos)
+{
+    return &storage[(pos & kLOG_MASK) / 4U];
+}
+
+static inline uint32_t logTotal(uint32_t len)
+{
+    return 4U + ((len + 3U) & ~3U);
+}
+
+/**
+ * @brief Release the record at the tail, its words read as free space again
+ *
+ * @return uint32_t New tail
+ */
+static uint32_t logRelease(uint32_t t, uint32_t *hdr, uint32_t len)
+{
+    uint32_t words = logTotal(len) / 4U;
+
+    for (uint32_t i = 0; i < words; i++) {
+        __atomic_store_n(&hdr[i], 0, __ATOMIC_RELAXED);
+    }
+    recOff = 0;
+    t += words * 4U;
+    __atomic_store_n(&tail, t, __ATOMIC_RELEASE);
+    return t;
+}
+
+
+void usbSerialJtag_logInit(void)
+{
+    for (uint32_t i = 0; i < USB_SERIAL_JTAG_CFG_LOG_RING_SIZE / 4U; i++) {
+        storage[i] = 0;
+    }
+    head = 0;
+    recOff = 0;
+    __atomic_store_n(&tail, 0, __ATOMIC_RELEASE);
+}
+
+uint8_t *usbSerialJtag_logReserve(uint32_t len)
+{
+    if (len > kUSB_SERIAL_JTAG_LOG_MAX_RECORD) {
+        __atomic_fetch_add(&dropped, 1U, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    uint32_t total = logTotal(len);
+    uint32_t h = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    uint32_t pad;
+
+    do {
+        uint32_t off = h & kLOG_MASK;
+        pad = (off + total > USB_SERIAL_JTAG_CFG_LOG_RING_SIZE) ? USB_SERIAL_JTAG_CFG_LOG_RING_SIZE - off : 0U;
+        if (h + pad + total - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) > USB_SERIAL_JTAG_CFG_LOG_RING_SIZE) {
+            __atomic_fetch_add(&dropped, 1U, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&head, &h, h + pad + total, 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    if (pad != 0) {
+        // The filler has no payload to wait for, it is committed right away
+        __atomic_store_n(logWord(h), mLOG_HDR_COMMIT | mLOG_HDR_PAD | (pad - 4U), __ATOMIC_RELEASE);
+        h += pad;
+    }
+
+    uint32_t *hdr = logWord(h);
+    __atomic_store_n(hdr, len, __ATOMIC_RELAXED);
+    return (uint8_t *) &hdr[1];
+}
+
+void usbSerialJtag_logCommit(uint8_t *rec)
+{
+    uint32_t *hdr = (uint32_t *) (void *) rec - 1;
+
+    __atomic_store_n(hdr, *hdr | mLOG_HDR_COMMIT, __ATOMIC_RELEASE);
+    usbSerialJtag_isrKickTx();
+}
+
+int usbSerialJtag_logWrite(const uint8_t *buf, uint32_t len)
+{
+    uint8_t *rec = usbSerialJtag_logReserve(len);
+
+    if (rec == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        rec[i] = buf[i];
+    }
+    usbSerialJtag_logCommit(rec);
+    return 0;
+}
+
+uint32_t usbSerialJtag_logDropped(void)
+{
+    return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+}
+
+uint32_t usbSerialJtag_logPending(void)
+{
+    uint32_t t = tail;
+
+    if (t == __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    return (__atomic_load_n(logWord(t), __ATOMIC_ACQUIRE) & mLOG_HDR_COMMIT) ? 1U : 0U;
+}
+
+uint32_t usbSerialJtag_logBusy(void)
+{
+    return (recOff != 0) ? 1U : 0U;
+}
+
+uint32_t usbSerialJtag_logFill(__usbSerialJtag_t *hw, uint32_t space)
+{
+    uint32_t pushed = 0;
+    uint32_t t = tail;
+
+    while (pushed < space && t != __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        uint32_t *hdr = logWord(t);
+        uint32_t word = __atomic_load_n(hdr, __ATOMIC_ACQUIRE);
+        if ((word & mLOG_HDR_COMMIT) == 0) {
+            break;
+        }
+
+        uint32_t len = word & mLOG_HDR_LEN;
+        if ((word & mLOG_HDR_PAD) == 0) {
+            uint32_t n = len - recOff;
+            if (n > space - pushed) {
+                n = space - pushed;
+            }
+            usbSerialJtag_txPush(hw, (const uint8_t *) &hdr[1] + recOff, n);
+            pushed += n;
+            recOff += n;
+            if (recOff < len) {
+                break;
+            }
+        }
+
+        // Free space reads as uncommitted headers, then the record is released
+        t = logRelease(t, hdr, len);
+    }
+
+    return pushed;
+}
+
+void usbSerialJtag_logFlush(void)
+{
+    uint32_t t = tail;
+
+    // The record in progress goes with the backlog, the next packet starts on a record boundary
+    while (t != __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        uint32_t *hdr = logWord(t);
+        uint32_t word = __atomic_load_n(hdr, __ATOMIC_ACQUIRE);
+        if ((word & mLOG_HDR_COMMIT) == 0) {
+            break;
+        }
+        t = logRelease(t, hdr, word & mLOG_HDR_LEN);
+    }
+    recOff = 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_LOG.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Multi-producer logging front end for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates a lock-free multi-producer/single-consumer record ring for the
+ * CDC-ACM IN endpoint. Any number of tasks and ISRs reserve a record, fill it in place and commit
+ * it; no mutex is taken. The records are streamed to the EP1 FIFO by the interrupt driver in
+ * reservation order, a record is always sent whole and never interleaved with other data.
+ *
+ * A record that is reserved and not committed yet holds back the records reserved after it, so a
+ * producer commits its record without waiting on anything in between.
+ *
+ * The ring is serviced by usbSerialJtag_isrHandler when USB_SERIAL_JTAG_CFG_LOG_ENABLE is 1.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_LOG_H
+#define USB_SERIAL_JTAG_ESP32_C6_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Constant definitions for the log ring
+ */
+#define kUSB_SERIAL_JTAG_LOG_MAX_RECORD (USB_SERIAL_JTAG_CFG_LOG_RING_SIZE / 2U - 4U) // Max payload of one record in bytes
+
+
+/**
+ * @brief Initialize the log ring (no producer may be active)
+ */
+void usbSerialJtag_logInit(void);
+
+/**
+ * @brief Reserve a record (any context, lock-free)
+ *
+ * @param len Payload length in bytes (up to kUSB_SERIAL_JTAG_LOG_MAX_RECORD)
+ * @return uint8_t* Payload of the record to be filled, NULL if the ring is full
+ */
+uint8_t *usbSerialJtag_logReserve(uint32_t len);
+
+/**
+ * @brief Commit a reserved record, it is sent once the records reserved before it are committed
+ *
+ * @param rec Payload returned by usbSerialJtag_logReserve
+ */
+void usbSerialJtag_logCommit(uint8_t *rec);
+
+/**
+ * @brief Reserve, copy and commit a record (any context, lock-free)
+ *
+ * @param buf Pointer to the data of the record
+ * @param len Number of bytes of the record
+ * @return int 0 on success, -1 if the ring is full (the record is dropped whole)
+ */
+int usbSerialJtag_logWrite(const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Number of records dropped because the ring was full
+ *
+ * @return uint32_t Free-running counter
+ */
+uint32_t usbSerialJtag_logDropped(void);
+
+/**
+ * @brief Whether a committed record is waiting for the FIFO (ISR side)
+ */
+uint32_t usbSerialJtag_logPending(void);
+
+/**
+ * @brief Whether a record is partially pushed to the FIFO (ISR side)
+ */
+uint32_t usbSerialJtag_logBusy(void);
+
+/**
+ * @brief Push committed records to the EP1 FIFO without committing the packet (ISR side)
+ *
+ * @param hw Register block
+ * @param space Free space of the FIFO
+ * @return uint32_t Number of bytes pushed
+ */
+uint32_t usbSerialJtag_logFill(__usbSerialJtag_t *hw, uint32_t space);
+
+/**
+ * @brief Drop the committed records, including the one partially pushed to the FIFO (ISR side)
+ *
+ * The walk stops at a record still being written by its producer: it is kept with the records
+ * behind it and they are sent after the flush.
+ */
+void usbSerialJtag_logFlush(void);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_LOG_H
\ No newline at end of file
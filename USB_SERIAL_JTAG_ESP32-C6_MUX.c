@@ -0,0 +1,313 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_MUX.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Virtual channel multiplexer over the CDC-ACM channel of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * Every channel has its own SPSC queue of message pointers. The ISR copies the next piece of the
+ * message at the tail into the cell buffer, which also holds the header, and streams the cell
+ * through the frame encoder. A message is released once its last piece is copied.
+ *
+ * The cell buffers of both directions are taken from the packet pool, a cell fits one buffer.
+ *
+ * The scheduler keeps a credit per channel: a channel is served while it has credit and it is
+ * pending at the highest pending level, the credits of a level are reloaded from the weights
+ * once all its pending channels used them.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_MUX.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_FRAME.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_POOL.h"
+
+_Static_assert((USB_SERIAL_JTAG_CFG_MUX_CHANNELS & (USB_SERIAL_JTAG_CFG_MUX_CHANNELS - 1U)) == 0, "Mux channel count must be a power of two");
+_Static_assert(USB_SERIAL_JTAG_CFG_MUX_CHANNELS <= mUSB_SERIAL_JTAG_MUX_CHAN + 1U, "Mux channel count must fit the cell header");
+_Static_assert(kUSB_SERIAL_JTAG_MUX_CELL_SIZE <= kUSB_SERIAL_JTAG_POOL_BUF_SIZE, "Mux cell must fit a pool buffer");
+_Static_assert((USB_SERIAL_JTAG_CFG_MUX_DEPTH & (USB_SERIAL_JTAG_CFG_MUX_DEPTH - 1U)) == 0, "Mux queue depth must be a power of two");
+
+#define kMUX_CHAN_MASK (USB_SERIAL_JTAG_CFG_MUX_CHANNELS - 1U)
+#define kMUX_DEPTH_MASK (USB_SERIAL_JTAG_CFG_MUX_DEPTH - 1U)
+#define kMUX_OVERHEAD (kUSB_SERIAL_JTAG_MUX_CELL_SIZE - kUSB_SERIAL_JTAG_MUX_CELL_PAYLOAD + 2U) // Header, CRC, COBS code and delimiter
+#define kMUX_FLAGS (USB_SERIAL_JTAG_CFG_MUX_CRC ? mUSB_SERIAL_JTAG_FRAME_CRC16 : 0U)
+#define kMUX_NO_LEVEL 0xFFFFFFFFUL
+
+typedef struct {
+    __usbSerialJtag_muxMsg_t *queue[USB_SERIAL_JTAG_CFG_MUX_DEPTH];
+    uint32_t head; // Written by the producer
+    uint32_t tail; // Written by the ISR
+    uint32_t off; // Bytes of the message at the tail already taken (ISR only)
+    uint32_t credit; // Cells left in the current round (ISR only)
+    uint32_t prio;
+    uint32_t weight;
+    uint32_t open;
+    __usbSerialJtag_muxRxCallback_t rx;
+    void *rxArg;
+} muxChan_t;
+
+static muxChan_t chans[USB_SERIAL_JTAG_CFG_MUX_CHANNELS];
+static uint32_t cursor = 0; // Channel served last (ISR only)
+
+// Cell in progress (ISR only)
+static uint8_t *cell = NULL; // Pool buffer
+static __usbSerialJtag_frameEnc_t enc;
+static uint32_t cellOpen = 0;
+
+// Receive side (consumer only)
+static uint8_t *rxCell = NULL; // Pool buffer
+static __usbSerialJtag_frameDec_t dec;
+static uint32_t rxErrors = 0;
+
+
+static inline uint32_t chanPending(const muxChan_t *c)
+{
+    return (__atomic_load_n(&c->head, __ATOMIC_ACQUIRE) != c->tail) ? 1U : 0U;
+}
+
+/**
+ * @brief Choose the channel of the next cell
+ *
+ * @return int Channel, -1 if nothing is queued
+ */
+static int muxPick(void)
+{
+    uint32_t level = kMUX_NO_LEVEL;
+
+    for (uint32_t ch = 0; ch < USB_SERIAL_JTAG_CFG_MUX_CHANNELS; ch++) {
+        if (chanPending(&chans[ch]) && chans[ch].prio < level) {
+            level = chans[ch].prio;
+        }
+    }
+    if (level == kMUX_NO_LEVEL) {
+        return -1;
+    }
+
+    for (uint32_t pass = 0; pass < 2U; pass++) {
+        // The channel served last keeps the packets while it has credit left
+        for (uint32_t i = 0; i < USB_SERIAL_JTAG_CFG_MUX_CHANNELS; i++) {
+            uint32_t ch = (cursor + i) & kMUX_CHAN_MASK;
+            muxChan_t *c = &chans[ch];
+            if (c->prio == level && c->credit != 0 && chanPending(c)) {
+                c->credit--;
+                cursor = (c->credit != 0) ? ch : ((ch + 1U) & kMUX_CHAN_MASK);
+                return (int) ch;
+            }
+        }
+
+        // Every pending channel of the level used its weight: next round
+        for (uint32_t ch = 0; ch < USB_SERIAL_JTAG_CFG_MUX_CHANNELS; ch++) {
+            if (chans[ch].prio == level) {
+                chans[ch].credit = chans[ch].weight;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Build the next cell, sized to the space left in the packet
+ *
+ * @param space Free space of the FIFO
+ * @return uint32_t 1 if a cell was started
+ */
+static uint32_t muxNextCell(uint32_t space)
+{
+    int pick = muxPick();
+
+    if (pick < 0) {
+        return 0;
+    }
+
+    muxChan_t *c = &chans[pick];
+    __usbSerialJtag_muxMsg_t *msg = c->queue[c->tail & kMUX_DEPTH_MASK];
+    uint32_t left = msg->len - c->off;
+    uint32_t n = kUSB_SERIAL_JTAG_MUX_CELL_PAYLOAD;
+
+    // Too little room for a useful cell: a full one spans into the next packet
+    if (space > kMUX_OVERHEAD && space - kMUX_OVERHEAD < n) {
+        n = space - kMUX_OVERHEAD;
+    }
+    if (n > left) {
+        n = left;
+    }
+
+    cell[0] = (uint8_t) ((uint32_t) pick | ((c->off == 0) ? mUSB_SERIAL_JTAG_MUX_START : 0U) | ((n == left) ? mUSB_SERIAL_JTAG_MUX_END : 0U));
+    for (uint32_t i = 0; i < n; i++) {
+        cell[1U + i] = msg->buf[c->off + i];
+    }
+    c->off += n;
+    usbSerialJtag_frameBegin(&enc, kUSB_SERIAL_JTAG_FRAME_COBS, kMUX_FLAGS, cell, 1U + n);
+    cellOpen = 1;
+
+    if (c->off == msg->len) {
+        // The message is in the cell buffer, its memory is released
+        c->off = 0;
+        __atomic_store_n(&c->tail, c->tail + 1U, __ATOMIC_RELEASE);
+        msg->sent = msg->len;
+        if (msg->done != NULL) {
+            msg->done(msg, msg->arg, kUSB_SERIAL_JTAG_MUX_SENT);
+        }
+    }
+    return 1;
+}
+
+
+int usbSerialJtag_muxInit(void)
+{
+    // The buffers are kept across calls, a failed call takes them on the next one
+    if (cell == NULL) {
+        cell = usbSerialJtag_poolAlloc();
+    }
+    if (rxCell == NULL) {
+        rxCell = usbSerialJtag_poolAlloc();
+    }
+
+    for (uint32_t ch = 0; ch < USB_SERIAL_JTAG_CFG_MUX_CHANNELS; ch++) {
+        muxChan_t *c = &chans[ch];
+        c->head = c->tail = 0;
+        c->off = 0;
+        c->credit = 0;
+        c->prio = 0;
+        c->weight = 1;
+        c->open = 0;
+        c->rx = NULL;
+        c->rxArg = NULL;
+    }
+    cursor = 0;
+    cellOpen = 0;
+    rxErrors = 0;
+    if (cell == NULL || rxCell == NULL) {
+        return -1;
+    }
+    usbSerialJtag_frameDecInit(&dec, kUSB_SERIAL_JTAG_FRAME_COBS, kMUX_FLAGS, rxCell, kUSB_SERIAL_JTAG_MUX_CELL_SIZE);
+    return 0;
+}
+
+int usbSerialJtag_muxOpen(uint32_t ch, uint32_t prio, uint32_t weight, __usbSerialJtag_muxRxCallback_t rx, void *arg)
+{
+    if (ch >= USB_SERIAL_JTAG_CFG_MUX_CHANNELS || weight == 0 || prio == kMUX_NO_LEVEL || cell == NULL || rxCell == NULL) {
+        return -1;
+    }
+
+    muxChan_t *c = &chans[ch];
+    c->prio = prio;
+    c->weight = weight;
+    c->credit = weight;
+    c->rx = rx;
+    c->rxArg = arg;
+    __atomic_store_n(&c->open, 1U, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int usbSerialJtag_muxSend(uint32_t ch, __usbSerialJtag_muxMsg_t *msg)
+{
+    if (ch >= USB_SERIAL_JTAG_CFG_MUX_CHANNELS || !__atomic_load_n(&chans[ch].open, __ATOMIC_ACQUIRE)) {
+        return -1;
+    }
+
+    muxChan_t *c = &chans[ch];
+    uint32_t h = c->head;
+
+    if (h - __atomic_load_n(&c->tail, __ATOMIC_ACQUIRE) >= USB_SERIAL_JTAG_CFG_MUX_DEPTH) {
+        return -1;
+    }
+    c->queue[h & kMUX_DEPTH_MASK] = msg;
+    __atomic_store_n(&c->head, h + 1U, __ATOMIC_RELEASE);
+
+    usbSerialJtag_isrKickTx();
+    return 0;
+}
+
+uint32_t usbSerialJtag_muxQueued(uint32_t ch)
+{
+    if (ch >= USB_SERIAL_JTAG_CFG_MUX_CHANNELS) {
+        return 0;
+    }
+    return __atomic_load_n(&chans[ch].head, __ATOMIC_ACQUIRE) - __atomic_load_n(&chans[ch].tail, __ATOMIC_ACQUIRE);
+}
+
+void usbSerialJtag_muxReceive(const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        int got = usbSerialJtag_frameDecPut(&dec, buf[i]);
+        if (got == kUSB_SERIAL_JTAG_FRAME_MORE) {
+            continue;
+        }
+        if (got == kUSB_SERIAL_JTAG_FRAME_ERROR) {
+            rxErrors++;
+            continue;
+        }
+
+        uint32_t ch = rxCell[0] & mUSB_SERIAL_JTAG_MUX_CHAN;
+        if (ch >= USB_SERIAL_JTAG_CFG_MUX_CHANNELS || !__atomic_load_n(&chans[ch].open, __ATOMIC_ACQUIRE)) {
+            rxErrors++;
+            continue;
+        }
+        muxChan_t *c = &chans[ch];
+        if (c->rx != NULL) {
+            c->rx(ch, &rxCell[1], (uint32_t) got - 1U, rxCell[0] & (mUSB_SERIAL_JTAG_MUX_START | mUSB_SERIAL_JTAG_MUX_END), c->rxArg);
+        }
+    }
+}
+
+uint32_t usbSerialJtag_muxRxErrors(void)
+{
+    return rxErrors;
+}
+
+uint32_t usbSerialJtag_muxBusy(void)
+{
+    return cellOpen;
+}
+
+uint32_t usbSerialJtag_muxPending(void)
+{
+    if (cellOpen) {
+        return 1;
+    }
+    for (uint32_t ch = 0; ch < USB_SERIAL_JTAG_CFG_MUX_CHANNELS; ch++) {
+        if (chanPending(&chans[ch])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void usbSerialJtag_muxFlush(void)
+{
+    cellOpen = 0;
+    for (uint32_t ch = 0; ch < USB_SERIAL_JTAG_CFG_MUX_CHANNELS; ch++) {
+        muxChan_t *c = &chans[ch];
+        uint32_t sent = c->off; // Only the message at the tail can be partially taken
+        c->off = 0;
+        while (chanPending(c)) {
+            __usbSerialJtag_muxMsg_t *msg = c->queue[c->tail & kMUX_DEPTH_MASK];
+            __atomic_store_n(&c->tail, c->tail + 1U, __ATOMIC_RELEASE);
+            msg->sent = sent;
+            sent = 0;
+            if (msg->done != NULL) {
+                msg->done(msg, msg->arg, kUSB_SERIAL_JTAG_MUX_CANCELLED);
+            }
+        }
+    }
+}
+
+uint32_t usbSerialJtag_muxFill(__usbSerialJtag_t *hw, uint32_t space)
+{
+    uint32_t pushed = 0;
+
+    while (pushed < space) {
+        if (!cellOpen && !muxNextCell(space - pushed)) {
+            break;
+        }
+        pushed += usbSerialJtag_frameEncode(hw, &enc, space - pushed);
+        if (usbSerialJtag_frameDone(&enc)) {
+            cellOpen = 0;
+        }
+    }
+
+    return pushed;
+}
\ No newline at end of file
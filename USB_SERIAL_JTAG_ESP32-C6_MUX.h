@@ -0,0 +1,169 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_MUX.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Virtual channel multiplexer over the CDC-ACM channel of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates a multiplexer of logical streams (console, telemetry, firmware
+ * update...) over the single EP1 pipe. A message queued on a channel is cut into cells, each cell
+ * is one COBS frame of the framing layer (USB_SERIAL_JTAG_ESP32-C6_FRAME.h) holding a header byte
+ * and up to kUSB_SERIAL_JTAG_MUX_CELL_PAYLOAD bytes of the message, then the CRC-16 with
+ * USB_SERIAL_JTAG_CFG_MUX_CRC. A cell is sized to the space left in the packet, so the cells start
+ * at the packet boundaries and a cell fits one 64-byte packet.
+ *
+ * The channel of every cell is chosen when it starts: strict priority between the levels (0 is
+ * the highest), weighted round robin between the channels of a level, the weight being the number
+ * of cells a channel sends in a row. A control message queued during a large transfer therefore
+ * waits for one packet at most.
+ *
+ * Cell header: bits 0-3 channel, bit 6 first cell of a message, bit 7 last cell of a message. The
+ * host sends its cells in the same format, the application passes the received bytes to
+ * usbSerialJtag_muxReceive and they are delivered per channel.
+ *
+ * The cells are scheduled by usbSerialJtag_isrHandler when USB_SERIAL_JTAG_CFG_MUX_ENABLE is 1. The
+ * data queued through the other TX paths is sent in between cells: with the multiplexer, the
+ * application sends everything through the channels.
+ *
+ * The TX and RX cell buffers are two buffers of the packet pool (USB_SERIAL_JTAG_ESP32-C6_POOL.h),
+ * held from usbSerialJtag_muxInit on: the pool is initialized first and not again while the
+ * multiplexer is in use.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_MUX_H
+#define USB_SERIAL_JTAG_ESP32_C6_MUX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Cell header fields
+ */
+#define mUSB_SERIAL_JTAG_MUX_CHAN 0x0FU // Channel of the cell
+#define mUSB_SERIAL_JTAG_MUX_START 0x40U // First cell of a message
+#define mUSB_SERIAL_JTAG_MUX_END 0x80U // Last cell of a message
+
+/**
+ * Constant definitions for the cells
+ */
+#define kUSB_SERIAL_JTAG_MUX_CELL_SIZE 62U // Max cell before encoding (COBS code and delimiter fill the packet)
+#define kUSB_SERIAL_JTAG_MUX_CELL_PAYLOAD (kUSB_SERIAL_JTAG_MUX_CELL_SIZE - 1U - (USB_SERIAL_JTAG_CFG_MUX_CRC ? 2U : 0U)) // Message bytes of a full cell
+
+/**
+ * Completion status of a message
+ */
+#define kUSB_SERIAL_JTAG_MUX_SENT 0U // Every byte is taken
+#define kUSB_SERIAL_JTAG_MUX_CANCELLED 1U // Dropped by usbSerialJtag_muxFlush, sent holds the bytes taken before
+
+typedef struct __usbSerialJtag_muxMsg __usbSerialJtag_muxMsg_t;
+
+/**
+ * \typedef __usbSerialJtag_muxCallback_t
+ * Completion callback of a message, called from the ISR once its last byte is taken or once it is
+ * dropped
+ */
+typedef void (*__usbSerialJtag_muxCallback_t)(__usbSerialJtag_muxMsg_t *msg, void *arg, uint32_t status);
+
+/**
+ * \typedef __usbSerialJtag_muxRxCallback_t
+ * Receive callback of a channel, called by usbSerialJtag_muxReceive for every valid cell
+ */
+typedef void (*__usbSerialJtag_muxRxCallback_t)(uint32_t ch, const uint8_t *data, uint32_t len, uint32_t flags, void *arg);
+
+/**
+ * \typedef __usbSerialJtag_muxMsg_t
+ * Message queued on a channel
+ */
+struct __usbSerialJtag_muxMsg {
+    const uint8_t *buf; // Payload, valid until the completion callback
+    uint32_t len; // Payload length in bytes
+    __usbSerialJtag_muxCallback_t done; // Completion callback (can be NULL)
+    void *arg; // Argument of the completion callback
+    uint32_t sent; // Bytes taken in cells, set by the ISR before the completion callback
+};
+
+
+/**
+ * @brief Close every channel and drop the queued messages without completion (no producer may be active)
+ *
+ * The first successful call takes the two cell buffers from the packet pool.
+ *
+ * @return int 0 on success, -1 if the pool has no buffer left (every channel stays closed)
+ */
+int usbSerialJtag_muxInit(void);
+
+/**
+ * @brief Set up a channel, before any message is queued on it
+ *
+ * @param ch Channel, below USB_SERIAL_JTAG_CFG_MUX_CHANNELS
+ * @param prio Priority level, 0 is the highest
+ * @param weight Cells sent in a row when the channel is served (>= 1)
+ * @param rx Receive callback (can be NULL)
+ * @param arg Argument of the receive callback
+ * @return int 0 on success, -1 if the channel or the weight is out of range or usbSerialJtag_muxInit failed
+ */
+int usbSerialJtag_muxOpen(uint32_t ch, uint32_t prio, uint32_t weight, __usbSerialJtag_muxRxCallback_t rx, void *arg);
+
+/**
+ * @brief Queue a message on a channel (single producer per channel)
+ *
+ * @param ch Channel
+ * @param msg Message, owned by the channel until its completion callback
+ * @return int 0 on success, -1 if the channel is not open or its queue is full
+ */
+int usbSerialJtag_muxSend(uint32_t ch, __usbSerialJtag_muxMsg_t *msg);
+
+/**
+ * @brief Number of messages queued or in progress on a channel
+ */
+uint32_t usbSerialJtag_muxQueued(uint32_t ch);
+
+/**
+ * @brief Decode received bytes and deliver the cells to the receive callbacks (single consumer)
+ *
+ * @param buf Received bytes
+ * @param len Number of bytes
+ */
+void usbSerialJtag_muxReceive(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Number of received cells dropped (malformed, CRC mismatch or channel not open)
+ *
+ * @return uint32_t Free-running counter
+ */
+uint32_t usbSerialJtag_muxRxErrors(void);
+
+/**
+ * @brief Whether a cell is partially pushed to the FIFO (ISR side)
+ */
+uint32_t usbSerialJtag_muxBusy(void);
+
+/**
+ * @brief Whether a cell is left to be pushed to the FIFO (ISR side)
+ */
+uint32_t usbSerialJtag_muxPending(void);
+
+/**
+ * @brief Complete the queued messages with kUSB_SERIAL_JTAG_MUX_CANCELLED and drop the cell in
+ * progress (ISR side)
+ */
+void usbSerialJtag_muxFlush(void);
+
+/**
+ * @brief Push the scheduled cells to the FIFO (ISR side)
+ *
+ * The bytes are pushed without committing the packet, the caller issues WR_DONE.
+ *
+ * @param hw Register block
+ * @param space Free space of the FIFO
+ * @return uint32_t Number of bytes pushed
+ */
+uint32_t usbSerialJtag_muxFill(__usbSerialJtag_t *hw, uint32_t space);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_MUX_H
\ No newline at end of file
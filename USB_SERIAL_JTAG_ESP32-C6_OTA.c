@@ -0,0 +1,227 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_OTA.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Pipelined firmware update receiver for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * Page p of the image is received in buffer p & 1. The ISR publishes the pages it filled in
+ * rxPage, the task publishes the pages it programmed in wrPage, the ISR never gets more than two
+ * pages ahead. When it would, it sets stalled and returns with the data in the FIFO; the task
+ * drains it once the buffer is written, with SERIAL_OUT_RECV_PKT_INT masked. The bytes that follow
+ * the image in its last packet are left to the ISR for the RX ring.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_OTA.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+_Static_assert(USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE >= 64U && (USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE & 3U) == 0, "OTA page size must be a multiple of 4 bytes, at least one packet");
+
+#define kOTA_PAGE USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE
+
+static const uint32_t crcNibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static _Alignas(4) uint8_t buffers[2][kOTA_PAGE];
+static const __usbSerialJtag_otaFlash_t *hooks = NULL;
+static uint32_t base = 0;
+static uint32_t imageSize = 0;
+static uint32_t pageCount = 0;
+static uint32_t state = kUSB_SERIAL_JTAG_OTA_IDLE;
+
+// Receive side, written by the ISR (or by the task with the interrupt masked)
+static uint32_t rxPage = 0; // Pages filled
+static uint32_t fill = 0; // Bytes of the page being filled
+static uint32_t received = 0;
+static uint32_t rxCrc = 0;
+static volatile uint32_t stalled = 0; // Data left in the FIFO, both buffers full
+static uint32_t stalls = 0;
+
+// Flash side, written by the task
+static uint32_t wrPage = 0; // Pages programmed
+static uint32_t erPage = 0; // Pages erased
+static uint32_t written = 0;
+
+
+/**
+ * @brief Move the OUT FIFO to the page buffers, up to the end of the image
+ *
+ * @param hw Register block
+ */
+static void otaDrain(__usbSerialJtag_t *hw)
+{
+    while (received < imageSize) {
+        uint32_t p = rxPage;
+        if (p - __atomic_load_n(&wrPage, __ATOMIC_ACQUIRE) >= 2U) {
+            // Both buffers wait for the flash: the packet stays in the FIFO and the host is NAKed
+            if (!stalled && (usbSerialJtag_hwRegRead(hw, ep1ConfReg) & mUSBSERIALJTAG_EP1CONFREG_SERIAL_OUT_EP_DATA_AVAIL)) {
+                stalled = 1;
+                stalls++;
+            }
+            return;
+        }
+
+        uint32_t room = kOTA_PAGE - fill;
+        if (room > imageSize - received) {
+            room = imageSize - received;
+        }
+        uint8_t *dst = &buffers[p & 1U][fill];
+        uint32_t got = (uint32_t) usbSerialJtag_read(hw, dst, room);
+        if (got == 0) {
+            return;
+        }
+
+        // The bytes were just written, the CRC pass reads them from the cache
+        rxCrc = usbSerialJtag_otaCrc32(rxCrc, dst, got);
+        fill += got;
+        received += got;
+        if (fill == kOTA_PAGE || received == imageSize) {
+            fill = 0;
+            __atomic_store_n(&rxPage, p + 1U, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**
+ * @brief Drain the data the ISR left in the FIFO (task side)
+ *
+ * @param drop 1 to drop the data instead of storing it
+ */
+static void otaResume(uint32_t drop)
+{
+    __usbSerialJtag_t *hw = usbSerialJtag_hw();
+
+    if (!stalled) {
+        return;
+    }
+
+    clrUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+    stalled = 0;
+    if (drop) {
+        uint8_t scratch[kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE];
+        while (usbSerialJtag_read(hw, scratch, sizeof(scratch)) != 0) {
+        }
+    } else {
+        otaDrain(hw);
+        if (received == imageSize && (usbSerialJtag_hwRegRead(hw, ep1ConfReg) & mUSBSERIALJTAG_EP1CONFREG_SERIAL_OUT_EP_DATA_AVAIL)) {
+            // The interrupt of this packet was served, the rest of it would never be drained
+            usbSerialJtag_isrKickRx();
+        }
+    }
+    setUSB_SERIAL_JTAG_INT_ENA(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+}
+
+static void otaStop(uint32_t next)
+{
+    __atomic_store_n(&state, next, __ATOMIC_RELEASE);
+    otaResume(1);
+}
+
+static int otaErase(void)
+{
+    if (hooks->erase(base + erPage * kOTA_PAGE, kOTA_PAGE, hooks->arg) != 0) {
+        otaStop(kUSB_SERIAL_JTAG_OTA_ERROR);
+        return -1;
+    }
+    erPage++;
+    return 0;
+}
+
+
+uint32_t usbSerialJtag_otaCrc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = (crc >> 4) ^ crcNibble[(crc ^ data[i]) & 0x0FU];
+        crc = (crc >> 4) ^ crcNibble[(crc ^ ((uint32_t) data[i] >> 4)) & 0x0FU];
+    }
+    return ~crc;
+}
+
+int usbSerialJtag_otaBegin(const __usbSerialJtag_otaFlash_t *flash, uint32_t addr, uint32_t size)
+{
+    if (__atomic_load_n(&state, __ATOMIC_ACQUIRE) == kUSB_SERIAL_JTAG_OTA_RECEIVING) {
+        return -1;
+    }
+    if (flash == NULL || flash->erase == NULL || flash->program == NULL || (addr % kOTA_PAGE) != 0 || size == 0) {
+        return -1;
+    }
+
+    hooks = flash;
+    base = addr;
+    imageSize = size;
+    pageCount = (size + kOTA_PAGE - 1U) / kOTA_PAGE;
+    rxPage = wrPage = erPage = 0;
+    fill = received = written = 0;
+    rxCrc = 0;
+    stalled = 0;
+    stalls = 0;
+    __atomic_store_n(&state, kUSB_SERIAL_JTAG_OTA_RECEIVING, __ATOMIC_RELEASE);
+    return 0;
+}
+
+uint32_t usbSerialJtag_otaPoll(void)
+{
+    while (__atomic_load_n(&state, __ATOMIC_ACQUIRE) == kUSB_SERIAL_JTAG_OTA_RECEIVING) {
+        if (wrPage != __atomic_load_n(&rxPage, __ATOMIC_ACQUIRE)) {
+            if (erPage == wrPage && otaErase() != 0) {
+                break;
+            }
+            uint32_t len = (wrPage == pageCount - 1U) ? imageSize - wrPage * kOTA_PAGE : kOTA_PAGE;
+            if (hooks->program(base + wrPage * kOTA_PAGE, buffers[wrPage & 1U], len, hooks->arg) != 0) {
+                otaStop(kUSB_SERIAL_JTAG_OTA_ERROR);
+                break;
+            }
+            written += len;
+            __atomic_store_n(&wrPage, wrPage + 1U, __ATOMIC_RELEASE);
+            otaResume(0);
+            if (wrPage == pageCount) {
+                __atomic_store_n(&state, kUSB_SERIAL_JTAG_OTA_DONE, __ATOMIC_RELEASE);
+            }
+        } else if (erPage == wrPage && erPage < pageCount) {
+            // The page being filled is erased meanwhile, its program does not wait for the erase
+            if (otaErase() != 0) {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+    return __atomic_load_n(&state, __ATOMIC_ACQUIRE);
+}
+
+void usbSerialJtag_otaAbort(void)
+{
+    if (__atomic_load_n(&state, __ATOMIC_ACQUIRE) == kUSB_SERIAL_JTAG_OTA_RECEIVING) {
+        otaStop(kUSB_SERIAL_JTAG_OTA_IDLE);
+    }
+}
+
+void usbSerialJtag_otaGetStatus(__usbSerialJtag_otaStatus_t *out)
+{
+    out->state = __atomic_load_n(&state, __ATOMIC_ACQUIRE);
+    out->size = imageSize;
+    out->received = __atomic_load_n(&received, __ATOMIC_RELAXED);
+    out->written = written;
+    out->crc = __atomic_load_n(&rxCrc, __ATOMIC_RELAXED);
+    out->stalls = __atomic_load_n(&stalls, __ATOMIC_RELAXED);
+}
+
+uint32_t usbSerialJtag_otaActive(void)
+{
+    return (__atomic_load_n(&state, __ATOMIC_ACQUIRE) == kUSB_SERIAL_JTAG_OTA_RECEIVING && received < imageSize) ? 1U : 0U;
+}
+
+void usbSerialJtag_otaOnRx(__usbSerialJtag_t *hw)
+{
+    if (!stalled) {
+        otaDrain(hw);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_OTA.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Pipelined firmware update receiver for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates a receive mode of the CDC-ACM channel for firmware images. While it
+ * is active, the interrupt driver drains the OUT packets (EP1_REC_DATA_CNT bulk reads) straight
+ * into two flash page buffers instead of the RX ring, and the CRC-32 of the image is updated
+ * right after every packet. The application task calls usbSerialJtag_otaPoll, which erases and
+ * programs the pages through the flash hooks of the application: one buffer is written to the
+ * flash while the ISR fills the other, and the next page is erased ahead while it is filled.
+ *
+ * There is no acknowledge protocol: once both buffers are waiting for the flash, the ISR leaves
+ * the received packet in the OUT FIFO, so the controller NAKs the host until a buffer is free.
+ * The host streams the image as fast as the flash takes it.
+ *
+ * The receive mode ends once the size given to usbSerialJtag_otaBegin is received, the bytes of
+ * the host that follow the image go to the RX ring again, those of the packet that ends the image
+ * included. The bytes already in the RX ring when
+ * the mode starts are not part of the image: the host starts the image once the command that
+ * starts the mode was answered.
+ *
+ * The pipeline is fed by usbSerialJtag_isrHandler when USB_SERIAL_JTAG_CFG_OTA_ENABLE is 1.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_OTA_H
+#define USB_SERIAL_JTAG_ESP32_C6_OTA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * States of the firmware update receiver
+ */
+#define kUSB_SERIAL_JTAG_OTA_IDLE 0U // No update, or aborted
+#define kUSB_SERIAL_JTAG_OTA_RECEIVING 1U // Image being received and written
+#define kUSB_SERIAL_JTAG_OTA_DONE 2U // Whole image written, check the CRC
+#define kUSB_SERIAL_JTAG_OTA_ERROR 3U // A flash hook failed, the update is stopped
+
+/**
+ * \typedef __usbSerialJtag_otaFlash_t
+ * Flash hooks of the application, called from usbSerialJtag_otaPoll
+ */
+typedef struct {
+    int (*erase)(uint32_t addr, uint32_t len, void *arg); // Erase one page, 0 on success
+    int (*program)(uint32_t addr, const uint8_t *buf, uint32_t len, void *arg); // Program up to one page (4-byte aligned buffer), 0 on success
+    void *arg; // Argument of the hooks
+} __usbSerialJtag_otaFlash_t;
+
+/**
+ * \typedef __usbSerialJtag_otaStatus_t
+ * Progress of the firmware update
+ */
+typedef struct {
+    uint32_t state; // kUSB_SERIAL_JTAG_OTA_xxx
+    uint32_t size; // Image size
+    uint32_t received; // Bytes drained from the FIFO
+    uint32_t written; // Bytes programmed to the flash
+    uint32_t crc; // CRC-32 of the bytes received
+    uint32_t stalls; // Times the ISR left a packet in the FIFO because both buffers were full
+} __usbSerialJtag_otaStatus_t;
+
+
+/**
+ * @brief Compute a CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320)
+ *
+ * @param crc 0 to start, or the accumulated value
+ * @param data Pointer to the data
+ * @param len Number of bytes
+ * @return uint32_t Accumulated CRC (final XOR included)
+ */
+uint32_t usbSerialJtag_otaCrc32(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Start the receive mode of a firmware image
+ *
+ * @param flash Flash hooks, must stay valid until the update ends
+ * @param addr Flash address of the image (multiple of USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE)
+ * @param size Image size in bytes
+ * @return int 0 on success, -1 if an update is running or the arguments are invalid
+ */
+int usbSerialJtag_otaBegin(const __usbSerialJtag_otaFlash_t *flash, uint32_t addr, uint32_t size);
+
+/**
+ * @brief Erase and program the pages received so far (application task)
+ *
+ * The flash hooks block the calling task only, the ISR keeps filling the other buffer.
+ *
+ * @return uint32_t State of the update, kUSB_SERIAL_JTAG_OTA_xxx
+ */
+uint32_t usbSerialJtag_otaPoll(void);
+
+/**
+ * @brief Stop the update, the packet left in the FIFO by a stall is dropped
+ */
+void usbSerialJtag_otaAbort(void);
+
+/**
+ * @brief Get the progress of the update
+ *
+ * @param out Status copy
+ */
+void usbSerialJtag_otaGetStatus(__usbSerialJtag_otaStatus_t *out);
+
+/**
+ * @brief Whether the OUT packets go to the page buffers (ISR side)
+ */
+uint32_t usbSerialJtag_otaActive(void);
+
+/**
+ * @brief Drain the OUT FIFO into the page buffers, on SERIAL_OUT_RECV_PKT_INT (ISR side)
+ *
+ * @param hw Register block
+ */
+void usbSerialJtag_otaOnRx(__usbSerialJtag_t *hw);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_OTA_H
\ No newline at end of file
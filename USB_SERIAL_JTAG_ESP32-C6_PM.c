@@ -0,0 +1,114 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_PM.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Idle power manager of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_PM.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+
+#define kPM_SUSPEND_CYCLES ((uint32_t) (USB_SERIAL_JTAG_CFG_PM_SUSPEND_FRAMES * kUSB_SERIAL_JTAG_CYCLES_PER_MS))
+
+#if USB_SERIAL_JTAG_CFG_PM_MEM_PD
+#define mPM_MEM_IDLE_SET mUSBSERIALJTAG_MEMCONFREG_USB_MEM_PD
+#else
+#define mPM_MEM_IDLE_SET 0U
+#endif
+
+static uint32_t state = kUSB_SERIAL_JTAG_PM_ACTIVE;
+static uint32_t lastFrame = 0; // Last SOF frame index seen
+static uint32_t lastFrameCycles = 0; // Cycle count when lastFrame was seen
+static uint32_t savedMemConf = 0; // memConfReg before the suspend
+static uint32_t savedMiscConf = 0; // miscConfReg before the suspend
+static __usbSerialJtag_pmStats_t stats;
+
+
+static uint32_t frameIndex(void)
+{
+    return usbSerialJtag_framNumSnapshot().BITS.SOF_FRAME_INDEX;
+}
+
+/**
+ * @brief Release the forced clocks, the configuration is kept for the resume
+ */
+static void pmSuspend(uint32_t now)
+{
+    savedMemConf = usbSerialJtag_memConfSnapshot().WORD;
+    savedMiscConf = usbSerialJtag_miscConfSnapshot().WORD;
+
+    usbSerialJtag_memConfModify(mUSBSERIALJTAG_MEMCONFREG_USB_MEM_CLK_EN, mPM_MEM_IDLE_SET);
+    clrUSB_SERIAL_JTAG_MISC_CONF(mUSBSERIALJTAG_MISCCONFREG_CLK_EN);
+
+    stats.suspendCount++;
+    lastFrameCycles = now;
+    state = kUSB_SERIAL_JTAG_PM_SUSPENDED;
+}
+
+/**
+ * @brief Restore the clocks and measure the restore time
+ */
+static void pmResume(uint32_t detected)
+{
+    // The register clock is enabled first, the memory configuration is written through it
+    __usbSerialJtag_miscConfReg_t misc;
+    misc.WORD = savedMiscConf;
+    usbSerialJtag_miscConfCommit(misc);
+    __usbSerialJtag_memConfReg_t mem;
+    mem.WORD = savedMemConf;
+    usbSerialJtag_memConfCommit(mem);
+
+    // Read back, the clocks are on once the write has reached the peripheral
+    (void) usbSerialJtag_memConfSnapshot();
+    uint32_t restore = usbSerialJtag_cycles() - detected;
+
+    stats.lastRestoreCycles = restore;
+    if (restore > stats.maxRestoreCycles) {
+        stats.maxRestoreCycles = restore;
+    }
+    stats.lastSuspendMs = (detected - lastFrameCycles) / (uint32_t) kUSB_SERIAL_JTAG_CYCLES_PER_MS;
+    state = kUSB_SERIAL_JTAG_PM_ACTIVE;
+}
+
+
+void usbSerialJtag_pmInit(void)
+{
+    usbSerialJtag_cyclesInit();
+    state = kUSB_SERIAL_JTAG_PM_ACTIVE;
+    lastFrame = frameIndex();
+    lastFrameCycles = usbSerialJtag_cycles();
+    stats = (__usbSerialJtag_pmStats_t) { 0 };
+}
+
+uint32_t usbSerialJtag_pmPoll(void)
+{
+    uint32_t now = usbSerialJtag_cycles();
+    uint32_t frame = frameIndex();
+
+    if (frame != lastFrame) {
+        // Bus activity: the host sends a SOF every frame
+        if (state == kUSB_SERIAL_JTAG_PM_SUSPENDED) {
+            pmResume(now);
+        }
+        lastFrame = frame;
+        lastFrameCycles = now;
+    } else if (state == kUSB_SERIAL_JTAG_PM_ACTIVE && now - lastFrameCycles >= kPM_SUSPEND_CYCLES) {
+        pmSuspend(now);
+    }
+
+    return state;
+}
+
+uint32_t usbSerialJtag_pmState(void)
+{
+    return state;
+}
+
+void usbSerialJtag_pmGetStats(__usbSerialJtag_pmStats_t *out)
+{
+    *out = stats;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_PM.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Idle power manager of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the idle manager of the controller clocks. The bus is considered
+ * suspended when the SOF frame index of framNumReg does not move for
+ * USB_SERIAL_JTAG_CFG_PM_SUSPEND_FRAMES frames. While suspended the forced clocks are released:
+ *
+ * - memConfReg.USB_MEM_CLK_EN = 0 (USB memory clocked on demand)
+ * - miscConfReg.CLK_EN = 0 (registers clocked only on access)
+ * - memConfReg.USB_MEM_PD = 1 when USB_SERIAL_JTAG_CFG_PM_MEM_PD is 1
+ *
+ * The first frame index change restores the saved configuration. The time taken by the restore,
+ * from the detection of the resume to the clocks being forced on again, is measured with the cycle
+ * counter of USB_SERIAL_JTAG_ESP32-C6_PORT.h and reported by usbSerialJtag_pmGetStats. It does not
+ * include the detection delay, up to one period of usbSerialJtag_pmPoll after the first SOF.
+ *
+ * usbSerialJtag_pmPoll is called periodically by the application (idle loop or timer tick), at a
+ * period shorter than one frame for an accurate suspend detection.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_PM_H
+#define USB_SERIAL_JTAG_ESP32_C6_PM_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * States of the idle manager
+ */
+#define kUSB_SERIAL_JTAG_PM_ACTIVE 0U // SOF received, clocks forced on as configured
+#define kUSB_SERIAL_JTAG_PM_SUSPENDED 1U // No SOF, clocks released
+
+/**
+ * \typedef __usbSerialJtag_pmStats_t
+ * Counters of the idle manager
+ */
+typedef struct {
+    uint32_t suspendCount; // Number of suspends detected
+    uint32_t lastRestoreCycles; // Cycles from the resume detection to the clocks restored (last resume)
+    uint32_t maxRestoreCycles; // Max of lastRestoreCycles
+    uint32_t lastSuspendMs; // Length of the last suspend
+} __usbSerialJtag_pmStats_t;
+
+
+/**
+ * @brief Initialize the idle manager and the cycle counter (bus considered active)
+ */
+void usbSerialJtag_pmInit(void);
+
+/**
+ * @brief Track the SOF frame index and switch the clocks on suspend/resume
+ *
+ * @return uint32_t Current state (kUSB_SERIAL_JTAG_PM_ACTIVE or kUSB_SERIAL_JTAG_PM_SUSPENDED)
+ */
+uint32_t usbSerialJtag_pmPoll(void);
+
+/**
+ * @brief Get the current state of the idle manager
+ *
+ * @return uint32_t kUSB_SERIAL_JTAG_PM_ACTIVE or kUSB_SERIAL_JTAG_PM_SUSPENDED
+ */
+uint32_t usbSerialJtag_pmState(void);
+
+/**
+ * @brief Get the counters of the idle manager
+ *
+ * @param out Copy of the counters
+ */
+void usbSerialJtag_pmGetStats(__usbSerialJtag_pmStats_t *out);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_PM_H
\ No newline at end of file
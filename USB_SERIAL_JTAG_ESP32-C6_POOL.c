@@ -0,0 +1,166 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_POOL.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Static pool of packet buffers for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * The top of the free stack is one 32-bit word, the index of the first free buffer in the low
+ * half and a tag bumped by every pop in the high half: a pop that raced with a pop and a push of
+ * the same buffer fails its compare-and-swap instead of linking a buffer in use.
+ *
+ * The owner of every buffer is kept next to it and moved with an exchange, a double release is
+ * seen by the second caller.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_POOL.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_TXQ.h"
+
+_Static_assert(USB_SERIAL_JTAG_CFG_POOL_BUFS >= 1U && USB_SERIAL_JTAG_CFG_POOL_BUFS < 0xFFFFU, "Packet pool must hold 1 to 65534 buffers");
+
+#define kPOOL_NIL 0xFFFFU // Index of the end of the free stack
+#define mPOOL_TOP_IDX 0x0000FFFFUL
+#define kPOOL_TOP_TAG 0x00010000UL
+
+// Owners of a buffer
+#define kPOOL_FREE 0U
+#define kPOOL_APP 1U
+#define kPOOL_ISR 2U
+
+static _Alignas(kUSB_SERIAL_JTAG_POOL_BUF_SIZE) uint8_t slabs[USB_SERIAL_JTAG_CFG_POOL_BUFS][kUSB_SERIAL_JTAG_POOL_BUF_SIZE];
+static uint16_t nextFree[USB_SERIAL_JTAG_CFG_POOL_BUFS]; // Next free buffer
+static uint8_t owner[USB_SERIAL_JTAG_CFG_POOL_BUFS];
+static uint32_t top = kPOOL_NIL;
+static uint32_t used = 0;
+static uint32_t highWater = 0;
+static uint32_t failed = 0;
+
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+static __usbSerialJtag_txqSeg_t txSeg[USB_SERIAL_JTAG_CFG_POOL_BUFS];
+static __usbSerialJtag_txqDesc_t txDesc[USB_SERIAL_JTAG_CFG_POOL_BUFS];
+#endif
+
+
+// Index of a buffer of the pool, kPOOL_NIL if buf is not one
+static uint32_t poolIndex(const uint8_t *buf)
+{
+    uintptr_t off = (uintptr_t) buf - (uintptr_t) &slabs[0][0];
+
+    if (off >= sizeof(slabs) || (off % kUSB_SERIAL_JTAG_POOL_BUF_SIZE) != 0) {
+        return kPOOL_NIL;
+    }
+    return (uint32_t) (off / kUSB_SERIAL_JTAG_POOL_BUF_SIZE);
+}
+
+static void poolPush(uint32_t idx)
+{
+    uint32_t t = __atomic_load_n(&top, __ATOMIC_RELAXED);
+
+    do {
+        nextFree[idx] = (uint16_t) (t & mPOOL_TOP_IDX);
+    } while (!__atomic_compare_exchange_n(&top, &t, (t & ~mPOOL_TOP_IDX) | idx, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_fetch_sub(&used, 1U, __ATOMIC_RELAXED);
+}
+
+// Move a buffer from one owner to the other, -1 if it was not owned by from
+static int poolHandOver(uint32_t idx, uint8_t from, uint8_t to)
+{
+    return __atomic_compare_exchange_n(&owner[idx], &from, to, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) ? 0 : -1;
+}
+
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+static void poolOnSent(__usbSerialJtag_txqDesc_t *desc, void *arg, uint32_t status)
+{
+    uint32_t idx = (uint32_t) (uintptr_t) arg;
+
+    // A packet dropped by a bus reset releases its buffer as well
+    (void) desc;
+    (void) status;
+    (void) poolHandOver(idx, kPOOL_ISR, kPOOL_FREE);
+    poolPush(idx);
+}
+#endif
+
+
+void usbSerialJtag_poolInit(void)
+{
+    for (uint32_t i = 0; i < USB_SERIAL_JTAG_CFG_POOL_BUFS; i++) {
+        nextFree[i] = (uint16_t) (i + 1U);
+        owner[i] = kPOOL_FREE;
+    }
+    nextFree[USB_SERIAL_JTAG_CFG_POOL_BUFS - 1U] = (uint16_t) kPOOL_NIL;
+    used = 0;
+    highWater = 0;
+    failed = 0;
+    __atomic_store_n(&top, 0, __ATOMIC_RELEASE);
+}
+
+uint8_t *usbSerialJtag_poolAlloc(void)
+{
+    uint32_t t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+    uint32_t idx;
+
+    do {
+        idx = t & mPOOL_TOP_IDX;
+        if (idx == kPOOL_NIL) {
+            __atomic_fetch_add(&failed, 1U, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        // nextFree[idx] can be stale when the buffer was taken meanwhile, the tag fails the swap
+    } while (!__atomic_compare_exchange_n(&top, &t, ((t & ~mPOOL_TOP_IDX) + kPOOL_TOP_TAG) | nextFree[idx], 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    owner[idx] = kPOOL_APP;
+    uint32_t n = __atomic_add_fetch(&used, 1U, __ATOMIC_RELAXED);
+    uint32_t hw = __atomic_load_n(&highWater, __ATOMIC_RELAXED);
+    while (n > hw && !__atomic_compare_exchange_n(&highWater, &hw, n, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+    return slabs[idx];
+}
+
+int usbSerialJtag_poolFree(uint8_t *buf)
+{
+    uint32_t idx = poolIndex(buf);
+
+    if (idx == kPOOL_NIL || poolHandOver(idx, kPOOL_APP, kPOOL_FREE) != 0) {
+        return -1;
+    }
+    poolPush(idx);
+    return 0;
+}
+
+int usbSerialJtag_poolSend(uint8_t *buf, uint32_t len)
+{
+#if USB_SERIAL_JTAG_CFG_TXQ_ENABLE
+    uint32_t idx = poolIndex(buf);
+
+    if (idx == kPOOL_NIL || len > kUSB_SERIAL_JTAG_POOL_BUF_SIZE || poolHandOver(idx, kPOOL_APP, kPOOL_ISR) != 0) {
+        return -1;
+    }
+    txSeg[idx].ptr = buf;
+    txSeg[idx].len = len;
+    txDesc[idx].segs = &txSeg[idx];
+    txDesc[idx].count = 1;
+    txDesc[idx].done = poolOnSent;
+    txDesc[idx].arg = (void *) (uintptr_t) idx;
+    if (usbSerialJtag_txqSubmit(&txDesc[idx]) != 0) {
+        (void) poolHandOver(idx, kPOOL_ISR, kPOOL_APP);
+        return -1;
+    }
+    return 0;
+#else
+    (void) buf;
+    (void) len;
+    return -1;
+#endif
+}
+
+void usbSerialJtag_poolStats(__usbSerialJtag_poolStats_t *out)
+{
+    out->total = USB_SERIAL_JTAG_CFG_POOL_BUFS;
+    out->used = __atomic_load_n(&used, __ATOMIC_RELAXED);
+    out->highWater = __atomic_load_n(&highWater, __ATOMIC_RELAXED);
+    out->failed = __atomic_load_n(&failed, __ATOMIC_RELAXED);
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_POOL.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Static pool of packet buffers for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates a fixed-capacity pool of buffers of one EP1 max packet (64 bytes),
+ * so the packet sized buffers of the application and of the layers built on the driver share one
+ * static store instead of each owning its worst case buffers. No heap is used. The multiplexer
+ * takes its TX and RX cell buffers from it (usbSerialJtag_muxInit), USB_SERIAL_JTAG_CFG_POOL_BUFS
+ * counts them.
+ *
+ * The buffers are aligned on 64 bytes, a buffer never crosses a cache line and can be copied with
+ * 32-bit loads. They are allocated and released from any context (task or ISR) without lock, the
+ * free list is a stack of indexes with a tag against ABA.
+ *
+ * A buffer is owned by the application from usbSerialJtag_poolAlloc until it is released with
+ * usbSerialJtag_poolFree or handed to the ISR with usbSerialJtag_poolSend, the ISR releases it
+ * once its last byte is in the FIFO. A buffer released twice or not owned by the application is
+ * rejected.
+ *
+ * The number of buffers is set with USB_SERIAL_JTAG_CFG_POOL_BUFS (see
+ * USB_SERIAL_JTAG_ESP32-C6_CONFIG.h).
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_POOL_H
+#define USB_SERIAL_JTAG_ESP32_C6_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+
+/**
+ * Constant definitions for the packet pool
+ */
+#define kUSB_SERIAL_JTAG_POOL_BUF_SIZE kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE // Size and alignment of a buffer in bytes
+
+/**
+ * \typedef __usbSerialJtag_poolStats_t
+ * Occupancy of the packet pool
+ */
+typedef struct {
+    uint32_t total; // Number of buffers
+    uint32_t used; // Buffers owned by the application or by the ISR
+    uint32_t highWater; // Max of used since usbSerialJtag_poolInit
+    uint32_t failed; // Allocations that found the pool empty
+} __usbSerialJtag_poolStats_t;
+
+
+/**
+ * @brief Release every buffer and reset the statistics (no buffer may be in use)
+ */
+void usbSerialJtag_poolInit(void);
+
+/**
+ * @brief Take a buffer (any context, lock-free)
+ *
+ * @return uint8_t* Buffer of kUSB_SERIAL_JTAG_POOL_BUF_SIZE bytes, NULL if the pool is empty
+ */
+uint8_t *usbSerialJtag_poolAlloc(void);
+
+/**
+ * @brief Release a buffer owned by the application (any context, lock-free)
+ *
+ * @param buf Buffer returned by usbSerialJtag_poolAlloc
+ * @return int 0 on success, -1 if buf is not an application owned buffer of the pool
+ */
+int usbSerialJtag_poolFree(uint8_t *buf);
+
+/**
+ * @brief Hand a buffer to the ISR for transmission, it is released once sent (single producer)
+ *
+ * The buffer is queued as a descriptor of the TX descriptor queue (needs
+ * USB_SERIAL_JTAG_CFG_TXQ_ENABLE), on failure it is still owned by the application.
+ *
+ * @param buf Buffer returned by usbSerialJtag_poolAlloc
+ * @param len Number of bytes to be sent (up to kUSB_SERIAL_JTAG_POOL_BUF_SIZE)
+ * @return int 0 on success, -1 if buf is not owned by the application, len is too large or the queue is full
+ */
+int usbSerialJtag_poolSend(uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Read the occupancy of the pool
+ *
+ * @param out Where the statistics are stored
+ */
+void usbSerialJtag_poolStats(__usbSerialJtag_poolStats_t *out);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_POOL_H
\ No newline at end of file
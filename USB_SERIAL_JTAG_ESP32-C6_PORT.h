@@ -0,0 +1,102 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_PORT.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Platform services used by the ESP32-C6 USB Serial JTAG driver
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file defines the CPU services the driver needs besides the controller registers. The
+ * cycle counter is the machine performance counter of the ESP32-C6 core (mpccr, 0x7E2), it counts
+ * CPU clock cycles once it is enabled by usbSerialJtag_cyclesInit.
+ *
+ * A host build without a RISC-V core can provide its own counter by defining
+ * USB_SERIAL_JTAG_PORT_CYCLES() before this file is included. The host register model provides
+ * the virtual time of the simulated bus (usbSerialJtag_simCycles).
+ *
+ * usbSerialJtag_irqLock masks the interrupts of the core (mstatus.MIE) for a short critical
+ * section. On the host the model only dispatches the handler from a register access, so the lock
+ * is empty there.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_PORT_H
+#define USB_SERIAL_JTAG_ESP32_C6_PORT_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+
+#if USB_SERIAL_JTAG_CFG_SIM_ENABLE && !defined(USB_SERIAL_JTAG_PORT_CYCLES)
+uint32_t usbSerialJtag_simCycles(void);
+#define USB_SERIAL_JTAG_PORT_CYCLES() usbSerialJtag_simCycles()
+#endif
+
+/**
+ * Constant definitions for the cycle counter
+ */
+#define kUSB_SERIAL_JTAG_CYCLES_PER_MS (USB_SERIAL_JTAG_CFG_CPU_FREQ_HZ / 1000UL) // CPU cycles in one millisecond (one Full-Speed frame)
+#define kUSB_SERIAL_JTAG_CYCLES_PER_US (USB_SERIAL_JTAG_CFG_CPU_FREQ_HZ / 1000000UL) // CPU cycles in one microsecond
+
+
+/**
+ * @brief Enable the cycle counter (machine performance counter counting clock cycles)
+ */
+static inline void usbSerialJtag_cyclesInit(void)
+{
+#if !defined(USB_SERIAL_JTAG_PORT_CYCLES) && defined(__riscv)
+    __asm__ volatile("csrw 0x7E0, %0" : : "r"(1U)); // mpcer: count clock cycles
+    __asm__ volatile("csrw 0x7E1, %0" : : "r"(1U)); // mpcmr: counter enabled
+#endif
+}
+
+/**
+ * @brief Read the cycle counter
+ *
+ * @return uint32_t Free-running CPU cycle count (wraps at 2^32)
+ */
+static inline uint32_t usbSerialJtag_cycles(void)
+{
+#if defined(USB_SERIAL_JTAG_PORT_CYCLES)
+    return USB_SERIAL_JTAG_PORT_CYCLES();
+#elif defined(__riscv)
+    uint32_t cycles;
+    __asm__ volatile("csrr %0, 0x7E2" : "=r"(cycles));
+    return cycles;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Mask the interrupts of the core
+ *
+ * @return uint32_t Key to be passed to usbSerialJtag_irqUnlock
+ */
+static inline uint32_t usbSerialJtag_irqLock(void)
+{
+#if defined(__riscv)
+    uint32_t mstatus;
+    __asm__ volatile("csrrci %0, mstatus, 8" : "=r"(mstatus) : : "memory");
+    return mstatus;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Restore the interrupt mask saved by usbSerialJtag_irqLock
+ *
+ * @param key Value returned by usbSerialJtag_irqLock
+ */
+static inline void usbSerialJtag_irqUnlock(uint32_t key)
+{
+#if defined(__riscv)
+    __asm__ volatile("csrs mstatus, %0" : : "r"(key & 8U) : "memory");
+#else
+    (void) key;
+#endif
+}
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_PORT_H
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_RECOVER.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Bus reset recovery of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_RECOVER.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+
+_Static_assert(!USB_SERIAL_JTAG_CFG_RECOVER_ENABLE || kUSB_SERIAL_JTAG_HAS_AFIFO_REGS, "Bus reset recovery requires the AFIFO registers (ESP32-C6/H2)");
+
+static uint32_t state = kUSB_SERIAL_JTAG_RECOVER_IDLE;
+static uint32_t startCycles = 0; // Cycle count of the USB_BUS_RESET_INT that started the recovery
+static uint32_t attempts = 0; // Reset pulses repeated by the current recovery
+static __usbSerialJtag_recoverStats_t stats;
+
+
+/**
+ * @brief Hold both clock domains of the async FIFOs and the JTAG FIFOs in reset
+ */
+static void recoverAssert(void)
+{
+    setUSB_SERIAL_JTAG_SER_AFIFO_CONFIC(mUSB_SERIAL_JTAG_RECOVER_AFIFO_WR | mUSB_SERIAL_JTAG_RECOVER_AFIFO_RD);
+    setUSB_SERIAL_JTAG_JFIFO_ST(mUSB_SERIAL_JTAG_RECOVER_JFIFO);
+}
+
+/**
+ * @brief Release the resets, the write side first so the read side comes out on an empty FIFO
+ *
+ * @return uint32_t 1 if the async FIFO flags are clean
+ */
+static uint32_t recoverRelease(void)
+{
+    clrUSB_SERIAL_JTAG_SER_AFIFO_CONFIC(mUSB_SERIAL_JTAG_RECOVER_AFIFO_WR);
+    clrUSB_SERIAL_JTAG_SER_AFIFO_CONFIC(mUSB_SERIAL_JTAG_RECOVER_AFIFO_RD);
+    clrUSB_SERIAL_JTAG_JFIFO_ST(mUSB_SERIAL_JTAG_RECOVER_JFIFO);
+
+    __usbSerialJtag_serAfifoConficReg_t afifo = usbSerialJtag_serAfifoConficSnapshot();
+    return (afifo.BITS.SERIAL_OUT_AFIFO_REMPTY == 1 && afifo.BITS.SERIAL_IN_AFIFO_WFULL == 0) ? 1U : 0U;
+}
+
+
+void usbSerialJtag_recoverInit(void)
+{
+    usbSerialJtag_cyclesInit();
+    state = kUSB_SERIAL_JTAG_RECOVER_IDLE;
+    attempts = 0;
+    stats = (__usbSerialJtag_recoverStats_t) { 0 };
+}
+
+void usbSerialJtag_recoverOnBusReset(void)
+{
+    __usbSerialJtag_serAfifoConficReg_t afifo = usbSerialJtag_serAfifoConficSnapshot();
+
+    stats.busResets++;
+    if (afifo.BITS.SERIAL_OUT_AFIFO_REMPTY == 0 || afifo.BITS.SERIAL_IN_AFIFO_WFULL == 1) {
+        stats.stale++;
+    }
+
+    // A reset during a recovery restarts it, the time is counted from the first one
+    if (state == kUSB_SERIAL_JTAG_RECOVER_IDLE) {
+        startCycles = usbSerialJtag_cycles();
+    }
+    attempts = 0;
+    recoverAssert();
+    state = kUSB_SERIAL_JTAG_RECOVER_RESET;
+}
+
+void usbSerialJtag_recoverOnSof(void)
+{
+    if (state != kUSB_SERIAL_JTAG_RECOVER_RESET || usbSerialJtag_busResetStSnapshot().BITS.BUS_RESET_ST == 0) {
+        return;
+    }
+
+    if (recoverRelease()) {
+        uint32_t took = usbSerialJtag_cycles() - startCycles;
+        stats.lastCycles = took;
+        if (took > stats.maxCycles) {
+            stats.maxCycles = took;
+        }
+        stats.recovered++;
+        state = kUSB_SERIAL_JTAG_RECOVER_IDLE;
+    } else if (attempts < USB_SERIAL_JTAG_CFG_RECOVER_RETRIES) {
+        // Pulsed again, released on the next SOF_INT
+        attempts++;
+        stats.retries++;
+        recoverAssert();
+    } else {
+        stats.failed++;
+        state = kUSB_SERIAL_JTAG_RECOVER_IDLE;
+    }
+}
+
+uint32_t usbSerialJtag_recoverState(void)
+{
+    return state;
+}
+
+void usbSerialJtag_recoverGetStats(__usbSerialJtag_recoverStats_t *out)
+{
+    *out = stats;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_RECOVER.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Bus reset recovery of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the recovery sequence run by the interrupt driver after a
+ * USB_BUS_RESET_INT, so the bytes of the previous session left in the CDC-ACM async FIFOs do not
+ * stall the channel of the next one:
+ *
+ * 1. USB_BUS_RESET_INT: the four SERIAL_IN/OUT_AFIFO_RESET_WR/RD bits and the JTAG
+ *    IN_FIFO_RESET/OUT_FIFO_RESET bits are set, the software side (TX ring, TX descriptor queue,
+ *    open TX packet, RX ring) is flushed and SOF_INT is enabled.
+ * 2. First SOF_INT with busResetStReg.BUS_RESET_ST set (bus reset released): the write clock
+ *    domains are released, then the read clock domains and the JTAG FIFOs.
+ * 3. The FIFOs are recovered once SERIAL_OUT_AFIFO_REMPTY is set and SERIAL_IN_AFIFO_WFULL is
+ *    clear. Otherwise the resets are set again and released on the next SOF_INT, at most
+ *    USB_SERIAL_JTAG_CFG_RECOVER_RETRIES times before the recovery is given up.
+ *
+ * Every step runs in the ISR. The time from the USB_BUS_RESET_INT to the FIFOs recovered is
+ * measured with the cycle counter of USB_SERIAL_JTAG_ESP32-C6_PORT.h and reported by
+ * usbSerialJtag_recoverGetStats, it includes the bus reset held by the host (10 ms minimum).
+ *
+ * The recovery is run by usbSerialJtag_isrHandler when USB_SERIAL_JTAG_CFG_RECOVER_ENABLE is 1.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_RECOVER_H
+#define USB_SERIAL_JTAG_ESP32_C6_RECOVER_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * States of the recovery
+ */
+#define kUSB_SERIAL_JTAG_RECOVER_IDLE 0U // FIFOs running
+#define kUSB_SERIAL_JTAG_RECOVER_RESET 1U // FIFOs held in reset, waiting for the bus reset to be released
+
+/**
+ * Reset bits of the recovery sequence
+ */
+#define mUSB_SERIAL_JTAG_RECOVER_AFIFO_WR (mUSBSERIALJTAG_SERAFIFOCONFICREG_SERIAL_IN_AFIFO_RESET_WR | mUSBSERIALJTAG_SERAFIFOCONFICREG_SERIAL_OUT_AFIFO_RESET_WR)
+#define mUSB_SERIAL_JTAG_RECOVER_AFIFO_RD (mUSBSERIALJTAG_SERAFIFOCONFICREG_SERIAL_IN_AFIFO_RESET_RD | mUSBSERIALJTAG_SERAFIFOCONFICREG_SERIAL_OUT_AFIFO_RESET_RD)
+#define mUSB_SERIAL_JTAG_RECOVER_JFIFO (mUSBSERIALJTAG_JFIFOSTREG_IN_FIFO_RESET | mUSBSERIALJTAG_JFIFOSTREG_OUT_FIFO_RESET)
+
+/**
+ * \typedef __usbSerialJtag_recoverStats_t
+ * Counters of the recovery
+ */
+typedef struct {
+    uint32_t busResets; // USB_BUS_RESET_INT served
+    uint32_t stale; // Bus resets that found the OUT async FIFO not empty or the IN async FIFO full
+    uint32_t recovered; // Recoveries completed
+    uint32_t retries; // Reset pulses repeated because the FIFO flags were not clean
+    uint32_t failed; // Recoveries given up after USB_SERIAL_JTAG_CFG_RECOVER_RETRIES
+    uint32_t lastCycles; // Cycles from the USB_BUS_RESET_INT to the FIFOs recovered (last recovery)
+    uint32_t maxCycles; // Max of lastCycles
+} __usbSerialJtag_recoverStats_t;
+
+
+/**
+ * @brief Reset the state and the counters of the recovery (FIFOs considered running)
+ */
+void usbSerialJtag_recoverInit(void);
+
+/**
+ * @brief USB_BUS_RESET_INT hook, holds the FIFOs in reset (ISR side)
+ *
+ * The caller flushes its software state and enables SOF_INT.
+ */
+void usbSerialJtag_recoverOnBusReset(void);
+
+/**
+ * @brief SOF_INT hook, releases and checks the FIFOs once the bus reset is released (ISR side)
+ */
+void usbSerialJtag_recoverOnSof(void);
+
+/**
+ * @brief Get the current state of the recovery
+ *
+ * @return uint32_t kUSB_SERIAL_JTAG_RECOVER_IDLE or kUSB_SERIAL_JTAG_RECOVER_RESET
+ */
+uint32_t usbSerialJtag_recoverState(void);
+
+/**
+ * @brief Get the counters of the recovery
+ *
+ * @param out Copy of the counters
+ */
+void usbSerialJtag_recoverGetStats(__usbSerialJtag_recoverStats_t *out);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_RECOVER_H
\ No newline at end of file
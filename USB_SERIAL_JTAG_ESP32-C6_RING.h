@@ -0,0 +1,171 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_RING.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Lock-free single-producer/single-consumer byte ring
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file defines the byte ring used by the interrupt driver to move data between the
+ * application and the ISR. One side only writes the head and the other side only writes the tail,
+ * so no critical section is needed as long as there is a single producer and a single consumer.
+ *
+ * The head and tail are free-running counters, the size of the storage must be a power of two.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_RING_H
+#define USB_SERIAL_JTAG_ESP32_C6_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \typedef __usbSerialJtag_ring_t
+ * SPSC byte ring
+ */
+typedef struct {
+    uint8_t *buf; // Storage of the ring
+    uint32_t mask; // Size of the storage minus one
+    uint32_t head; // Write counter, only written by the producer
+    uint32_t tail; // Read counter, only written by the consumer
+} __usbSerialJtag_ring_t;
+
+
+/**
+ * @brief Initialize a ring over a storage of size bytes (power of two)
+ */
+static inline void usbSerialJtag_ringInit(__usbSerialJtag_ring_t *ring, uint8_t *buf, uint32_t size)
+{
+    ring->buf = buf;
+    ring->mask = size - 1U;
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+/**
+ * @brief Number of bytes stored in the ring
+ */
+static inline uint32_t usbSerialJtag_ringCount(const __usbSerialJtag_ring_t *ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Number of bytes that can be stored in the ring
+ */
+static inline uint32_t usbSerialJtag_ringFree(const __usbSerialJtag_ring_t *ring)
+{
+    return ring->mask + 1U - usbSerialJtag_ringCount(ring);
+}
+
+/**
+ * @brief Get the contiguous readable region of the ring (consumer side)
+ *
+ * @param len Set to the length of the region
+ * @return const uint8_t* Start of the region
+ */
+static inline const uint8_t *usbSerialJtag_ringReadPtr(const __usbSerialJtag_ring_t *ring, uint32_t *len)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = ring->tail;
+    uint32_t idx = tail & ring->mask;
+    uint32_t count = head - tail;
+    uint32_t toEnd = ring->mask + 1U - idx;
+
+    *len = (count < toEnd) ? count : toEnd;
+    return &ring->buf[idx];
+}
+
+/**
+ * @brief Release len bytes previously obtained with usbSerialJtag_ringReadPtr (consumer side)
+ */
+static inline void usbSerialJtag_ringConsume(__usbSerialJtag_ring_t *ring, uint32_t len)
+{
+    __atomic_store_n(&ring->tail, ring->tail + len, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Get the contiguous writable region of the ring (producer side)
+ *
+ * @param len Set to the length of the region
+ * @return uint8_t* Start of the region
+ */
+static inline uint8_t *usbSerialJtag_ringWritePtr(__usbSerialJtag_ring_t *ring, uint32_t *len)
+{
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    uint32_t idx = head & ring->mask;
+    uint32_t space = ring->mask + 1U - (head - tail);
+    uint32_t toEnd = ring->mask + 1U - idx;
+
+    *len = (space < toEnd) ? space : toEnd;
+    return &ring->buf[idx];
+}
+
+/**
+ * @brief Publish len bytes previously written through usbSerialJtag_ringWritePtr (producer side)
+ */
+static inline void usbSerialJtag_ringCommit(__usbSerialJtag_ring_t *ring, uint32_t len)
+{
+    __atomic_store_n(&ring->head, ring->head + len, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copy up to len bytes into the ring (producer side)
+ *
+ * @return size_t Number of bytes copied
+ */
+static inline size_t usbSerialJtag_ringPut(__usbSerialJtag_ring_t *ring, const uint8_t *data, size_t len)
+{
+    size_t done = 0;
+
+    while (done < len) {
+        uint32_t room;
+        uint8_t *dst = usbSerialJtag_ringWritePtr(ring, &room);
+        if (room == 0) {
+            break;
+        }
+        if (room > len - done) {
+            room = (uint32_t) (len - done);
+        }
+        for (uint32_t i = 0; i < room; i++) {
+            dst[i] = data[done + i];
+        }
+        usbSerialJtag_ringCommit(ring, room);
+        done += room;
+    }
+
+    return done;
+}
+
+/**
+ * @brief Copy up to max bytes out of the ring (consumer side)
+ *
+ * @return size_t Number of bytes copied
+ */
+static inline size_t usbSerialJtag_ringGet(__usbSerialJtag_ring_t *ring, uint8_t *data, size_t max)
+{
+    size_t done = 0;
+
+    while (done < max) {
+        uint32_t avail;
+        const uint8_t *src = usbSerialJtag_ringReadPtr(ring, &avail);
+        if (avail == 0) {
+            break;
+        }
+        if (avail > max - done) {
+            avail = (uint32_t) (max - done);
+        }
+        for (uint32_t i = 0; i < avail; i++) {
+            data[done + i] = src[i];
+        }
+        usbSerialJtag_ringConsume(ring, avail);
+        done += avail;
+    }
+
+    return done;
+}
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_RING_H
\ No newline at end of file
@@ -0,0 +1,137 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_STATS.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Runtime statistics and error counters of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * The counters are free-running 32-bit words. The live block is only written by
+ * usbSerialJtag_statsAdd (ISR), a reset stores a baseline (live plus deferred counters) that is
+ * subtracted by the snapshot, so the ISR stays the single writer of the sequence lock.
+ *
+ * usbSerialJtag_statsSnapshot spins while a write is in progress: do not call it from an
+ * interrupt that can preempt the USB Serial JTAG ISR.
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_STATS.h"
+
+#define kSTATS_WORDS (sizeof(__usbSerialJtag_stats_t) / sizeof(uint32_t))
+
+static __usbSerialJtag_stats_t live; // Written by the ISR inside the sequence lock
+static __usbSerialJtag_stats_t deferred; // Counters from outside the ISR, merged by the ISR
+static __usbSerialJtag_stats_t base; // Snapshot taken by the last reset
+static uint32_t seq = 0; // Odd while the ISR updates live
+static uint32_t rxModPackets = 0; // Settings reported as they are, not accumulated
+static uint32_t rxModUs = 0;
+
+
+static inline void wordAdd(uint32_t *dst, uint32_t value)
+{
+    __atomic_store_n(dst, __atomic_load_n(dst, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Add the data path fields of src to dst (live block, inside the write section)
+ */
+static void addDataPath(__usbSerialJtag_stats_t *dst, const __usbSerialJtag_stats_t *src)
+{
+    wordAdd(&dst->ep1InBytes, src->ep1InBytes);
+    wordAdd(&dst->ep1InPackets, src->ep1InPackets);
+    wordAdd(&dst->ep1OutBytes, src->ep1OutBytes);
+    wordAdd(&dst->ep1OutPackets, src->ep1OutPackets);
+    wordAdd(&dst->txFifoFull, src->txFifoFull);
+    wordAdd(&dst->rxRingFull, src->rxRingFull);
+    wordAdd(&dst->rxModRounds, src->rxModRounds);
+    wordAdd(&dst->rxModPolled, src->rxModPolled);
+}
+
+/**
+ * @brief Take a consistent copy of the live block plus the deferred counters
+ *
+ * The ISR moves the deferred counters to the live block inside its write section, so both blocks
+ * are read within the same sequence: a merge between the two reads makes the copy retry.
+ */
+static void readTotal(__usbSerialJtag_stats_t *out)
+{
+    const uint32_t *src = (const uint32_t *) &live;
+    const uint32_t *d = (const uint32_t *) &deferred;
+    uint32_t *dst = (uint32_t *) out;
+    uint32_t s1;
+    uint32_t s2;
+
+    do {
+        s1 = __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+        for (uint32_t i = 0; i < kSTATS_WORDS; i++) {
+            dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED) + __atomic_load_n(&d[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        s2 = __atomic_load_n(&seq, __ATOMIC_RELAXED);
+    } while ((s1 & 1U) != 0 || s1 != s2);
+}
+
+
+void usbSerialJtag_statsReset(void)
+{
+    readTotal(&base);
+}
+
+void usbSerialJtag_statsSnapshot(__usbSerialJtag_stats_t *out)
+{
+    const uint32_t *b = (const uint32_t *) &base;
+    uint32_t *o = (uint32_t *) out;
+
+    readTotal(out);
+    for (uint32_t i = 0; i < kSTATS_WORDS; i++) {
+        o[i] -= b[i];
+    }
+    out->rxModPackets = __atomic_load_n(&rxModPackets, __ATOMIC_RELAXED);
+    out->rxModUs = __atomic_load_n(&rxModUs, __ATOMIC_RELAXED);
+}
+
+void usbSerialJtag_statsAdd(uint32_t raw, const __usbSerialJtag_stats_t *delta)
+{
+    __atomic_store_n(&seq, seq + 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    wordAdd(&live.pidErr, (raw & mUSBSERIALJTAG_INTSTATUSREG_PID_ERR_INT) ? 1U : 0U);
+    wordAdd(&live.crc5Err, (raw & mUSBSERIALJTAG_INTSTATUSREG_CRC5_ERR_INT) ? 1U : 0U);
+    wordAdd(&live.crc16Err, (raw & mUSBSERIALJTAG_INTSTATUSREG_CRC16_ERR_INT) ? 1U : 0U);
+    wordAdd(&live.stuffErr, (raw & mUSBSERIALJTAG_INTSTATUSREG_STUFF_ERR_INT) ? 1U : 0U);
+    wordAdd(&live.busReset, (raw & mUSBSERIALJTAG_INTSTATUSREG_USB_BUS_RESET_INT) ? 1U : 0U);
+    wordAdd(&live.ep1ZeroPayload, (raw & mUSBSERIALJTAG_INTSTATUSREG_OUT_EP1_ZERO_PAYLOAD_INT) ? 1U : 0U);
+    wordAdd(&live.ep2ZeroPayload, (raw & mUSBSERIALJTAG_INTSTATUSREG_OUT_EP2_ZERO_PAYLOAD_INT) ? 1U : 0U);
+    wordAdd(&live.isrCount, 1);
+    addDataPath(&live, delta);
+
+    // Move the counters collected outside the ISR into the live block
+    __usbSerialJtag_stats_t moved = { 0 };
+    moved.ep1InBytes = __atomic_exchange_n(&deferred.ep1InBytes, 0, __ATOMIC_RELAXED);
+    moved.ep1InPackets = __atomic_exchange_n(&deferred.ep1InPackets, 0, __ATOMIC_RELAXED);
+    moved.ep1OutBytes = __atomic_exchange_n(&deferred.ep1OutBytes, 0, __ATOMIC_RELAXED);
+    moved.ep1OutPackets = __atomic_exchange_n(&deferred.ep1OutPackets, 0, __ATOMIC_RELAXED);
+    moved.txFifoFull = __atomic_exchange_n(&deferred.txFifoFull, 0, __ATOMIC_RELAXED);
+    moved.rxRingFull = __atomic_exchange_n(&deferred.rxRingFull, 0, __ATOMIC_RELAXED);
+    addDataPath(&live, &moved);
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&seq, seq + 1U, __ATOMIC_RELAXED);
+}
+
+void usbSerialJtag_statsAddDeferred(const __usbSerialJtag_stats_t *delta)
+{
+    __atomic_fetch_add(&deferred.ep1InBytes, delta->ep1InBytes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&deferred.ep1InPackets, delta->ep1InPackets, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&deferred.ep1OutBytes, delta->ep1OutBytes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&deferred.ep1OutPackets, delta->ep1OutPackets, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&deferred.txFifoFull, delta->txFifoFull, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&deferred.rxRingFull, delta->rxRingFull, __ATOMIC_RELAXED);
+}
+
+void usbSerialJtag_statsSetRxModeration(uint32_t packets, uint32_t us)
+{
+    __atomic_store_n(&rxModPackets, packets, __ATOMIC_RELAXED);
+    __atomic_store_n(&rxModUs, us, __ATOMIC_RELAXED);
+}
\ No newline at end of file
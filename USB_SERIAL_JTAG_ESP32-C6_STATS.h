@@ -0,0 +1,106 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_STATS.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Runtime statistics and error counters of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the instrumentation block of the interrupt driver. The ISR counts
+ * the bus error and event sources of intRawReg (PID, CRC5, CRC16, bit stuffing, bus reset, zero
+ * payload packets), the bytes and packets of the CDC-ACM endpoint and the stalls of the data path.
+ *
+ * The block is written by the ISR only, inside a sequence lock. usbSerialJtag_statsSnapshot takes
+ * a consistent copy from any context without disabling interrupts.
+ *
+ * The counters are collected when USB_SERIAL_JTAG_CFG_STATS_ENABLE is 1.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_STATS_H
+#define USB_SERIAL_JTAG_ESP32_C6_STATS_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * Interrupt sources counted by the statistics block
+ */
+#define mUSB_SERIAL_JTAG_STATS_EVENTS (mUSBSERIALJTAG_INTSTATUSREG_PID_ERR_INT | mUSBSERIALJTAG_INTSTATUSREG_CRC5_ERR_INT | \
+                                       mUSBSERIALJTAG_INTSTATUSREG_CRC16_ERR_INT | mUSBSERIALJTAG_INTSTATUSREG_STUFF_ERR_INT | \
+                                       mUSBSERIALJTAG_INTSTATUSREG_USB_BUS_RESET_INT | mUSBSERIALJTAG_INTSTATUSREG_OUT_EP1_ZERO_PAYLOAD_INT | \
+                                       mUSBSERIALJTAG_INTSTATUSREG_OUT_EP2_ZERO_PAYLOAD_INT)
+
+/**
+ * \typedef __usbSerialJtag_stats_t
+ * Runtime statistics
+ */
+typedef struct {
+    // Bus errors and events (intRawReg)
+    uint32_t pidErr; // PID_ERR_INT
+    uint32_t crc5Err; // CRC5_ERR_INT
+    uint32_t crc16Err; // CRC16_ERR_INT
+    uint32_t stuffErr; // STUFF_ERR_INT
+    uint32_t busReset; // USB_BUS_RESET_INT
+    uint32_t ep1ZeroPayload; // OUT_EP1_ZERO_PAYLOAD_INT
+    uint32_t ep2ZeroPayload; // OUT_EP2_ZERO_PAYLOAD_INT
+
+    // CDC-ACM data endpoint (EP1)
+    uint32_t ep1InBytes; // Bytes pushed to the IN FIFO
+    uint32_t ep1InPackets; // Packets committed with WR_DONE
+    uint32_t ep1OutBytes; // Bytes drained from the OUT FIFO
+    uint32_t ep1OutPackets; // Packets drained from the OUT FIFO
+
+    // Data path stalls
+    uint32_t txFifoFull; // TX data pending while the IN FIFO had no space
+    uint32_t rxRingFull; // RX ring full while data was left in the OUT FIFO
+
+    // RX interrupt moderation
+    uint32_t rxModRounds; // Rounds polled with SERIAL_OUT_RECV_PKT_INT masked
+    uint32_t rxModPolled; // Packets drained by the SOF_INT of the rounds
+    uint32_t rxModPackets; // Current packet budget of a round (setting, not a counter)
+    uint32_t rxModUs; // Current length limit of a round (setting, not a counter)
+
+    uint32_t isrCount; // ISR entries
+} __usbSerialJtag_stats_t;
+
+
+/**
+ * @brief Reset all the counters
+ */
+void usbSerialJtag_statsReset(void);
+
+/**
+ * @brief Take a consistent copy of the counters (any context, lock-free)
+ *
+ * @param out Copy of the counters
+ */
+void usbSerialJtag_statsSnapshot(__usbSerialJtag_stats_t *out);
+
+/**
+ * @brief Add the counters collected by one ISR entry (ISR side, single writer)
+ *
+ * @param raw intRawReg value, the mUSB_SERIAL_JTAG_STATS_EVENTS bits are counted
+ * @param delta Counters to be added (the event fields are ignored)
+ */
+void usbSerialJtag_statsAdd(uint32_t raw, const __usbSerialJtag_stats_t *delta);
+
+/**
+ * @brief Add counters collected outside the ISR, they are merged by the next ISR entry
+ *
+ * @param delta Counters to be added (the event fields are ignored)
+ */
+void usbSerialJtag_statsAddDeferred(const __usbSerialJtag_stats_t *delta);
+
+/**
+ * @brief Record the moderation settings reported by usbSerialJtag_statsSnapshot
+ *
+ * @param packets Packet budget of a round
+ * @param us Length limit of a round in microseconds
+ */
+void usbSerialJtag_statsSetRxModeration(uint32_t packets, uint32_t us);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_STATS_H
\ No newline at end of file
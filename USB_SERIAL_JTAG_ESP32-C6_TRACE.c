@@ -0,0 +1,265 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_TRACE.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Register access tracing and MMIO cost profiler of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * The per-register counters are indexed by the word offset of the access. The trace buffer is a
+ * ring claimed with one atomic increment per entry, the newest entries overwrite the oldest.
+ *
+ * The per-function table is an open-addressed hash of the __func__ pointers (one string per
+ * function, the pointer is the key). Functions that do not fit in the table are counted in a
+ * single overflow counter.
+ *
+ */
+
+#include <stddef.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_TRACE.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+
+_Static_assert((USB_SERIAL_JTAG_CFG_TRACE_DEPTH & (USB_SERIAL_JTAG_CFG_TRACE_DEPTH - 1U)) == 0, "Trace buffer depth must be a power of two");
+_Static_assert((USB_SERIAL_JTAG_CFG_TRACE_SITES & (USB_SERIAL_JTAG_CFG_TRACE_SITES - 1U)) == 0 && USB_SERIAL_JTAG_CFG_TRACE_SITES != 0, "Trace site table size must be a power of two");
+_Static_assert(sizeof(__usbSerialJtag_t) == kUSB_SERIAL_JTAG_TRACE_REGS * 4U, "Trace register count does not match the module structure");
+
+#define kTRACE_BUFFER (USB_SERIAL_JTAG_CFG_TRACE_DEPTH != 0 ? USB_SERIAL_JTAG_CFG_TRACE_DEPTH : 1U)
+#define kTRACE_BAR 32U // Width of the longest histogram bar
+#define kTRACE_LINE 96U
+
+static __usbSerialJtag_traceCount_t counts[kUSB_SERIAL_JTAG_TRACE_REGS];
+static __usbSerialJtag_traceEntry_t buffer[kTRACE_BUFFER];
+static __usbSerialJtag_traceSite_t sites[USB_SERIAL_JTAG_CFG_TRACE_SITES];
+static uint32_t sitesLost = 0; // r/b macro accesses of the functions that did not fit in sites
+static uint32_t head = 0; // Entries written since the reset
+static uint32_t enabled = 1;
+
+static const char *const names[kUSB_SERIAL_JTAG_TRACE_REGS] = {
+    "ep1Reg", "ep1ConfReg", "intRawReg", "intStReg", "intEnaReg", "intClrReg", "conf0Reg", "testReg",
+    "jfifoStReg", "framNumReg", "inEp0StReg", "inEp1StReg", "inEp2StReg", "inEp3StReg", "outEp0StReg", "outEp1StReg",
+    "outEp2StReg", "miscConfReg", "memConfReg", "chipRstReg", "setLineCodeW0Reg", "setLineCodeW1Reg", "getLineCodeW0Reg", "getLineCodeW1Reg",
+    "configUpdateReg", "serAfifoConficReg", "busResetStReg", "RESERVED_0", "RESERVED_0", "RESERVED_0", "RESERVED_0", "RESERVED_0",
+    "dateReg",
+};
+
+
+static inline void countAdd(uint32_t *counter)
+{
+    __atomic_fetch_add(counter, 1U, __ATOMIC_RELAXED);
+}
+
+static inline void countClear(uint32_t *counter)
+{
+    __atomic_store_n(counter, 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Append text to a line, truncated to the line size
+ */
+static uint32_t lineText(char *line, uint32_t pos, const char *text)
+{
+    while (*text != '\0' && pos < kTRACE_LINE - 1U) {
+        line[pos++] = *text++;
+    }
+    line[pos] = '\0';
+    return pos;
+}
+
+/**
+ * @brief Append a number to a line, right aligned in width characters
+ */
+static uint32_t lineNumber(char *line, uint32_t pos, uint32_t value, uint32_t base, uint32_t width)
+{
+    char digits[11];
+    uint32_t n = 0;
+
+    do {
+        uint32_t d = value % base;
+        digits[n++] = (char) (d < 10U ? '0' + d : 'A' + d - 10U);
+        value /= base;
+    } while (value != 0);
+    while (width > n && pos < kTRACE_LINE - 1U) {
+        line[pos++] = (base == 16U) ? '0' : ' ';
+        width--;
+    }
+    while (n != 0 && pos < kTRACE_LINE - 1U) {
+        line[pos++] = digits[--n];
+    }
+    line[pos] = '\0';
+    return pos;
+}
+
+static uint32_t registerTotal(const __usbSerialJtag_traceCount_t *c)
+{
+    return c->reads + c->writes + c->amos;
+}
+
+
+void usbSerialJtag_traceReset(void)
+{
+    for (uint32_t i = 0; i < kUSB_SERIAL_JTAG_TRACE_REGS; i++) {
+        countClear(&counts[i].reads);
+        countClear(&counts[i].writes);
+        countClear(&counts[i].amos);
+    }
+    for (uint32_t i = 0; i < USB_SERIAL_JTAG_CFG_TRACE_SITES; i++) {
+        countClear(&sites[i].count);
+    }
+    countClear(&sitesLost);
+    countClear(&head);
+}
+
+void usbSerialJtag_traceEnable(uint32_t enable)
+{
+    __atomic_store_n(&enabled, (enable != 0) ? 1U : 0U, __ATOMIC_RELAXED);
+}
+
+int usbSerialJtag_traceCount(uint32_t index, __usbSerialJtag_traceCount_t *out)
+{
+    if (index >= kUSB_SERIAL_JTAG_TRACE_REGS) {
+        return -1;
+    }
+    out->reads = __atomic_load_n(&counts[index].reads, __ATOMIC_RELAXED);
+    out->writes = __atomic_load_n(&counts[index].writes, __ATOMIC_RELAXED);
+    out->amos = __atomic_load_n(&counts[index].amos, __ATOMIC_RELAXED);
+    return 0;
+}
+
+uint32_t usbSerialJtag_traceSites(__usbSerialJtag_traceSite_t *out, uint32_t max)
+{
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < USB_SERIAL_JTAG_CFG_TRACE_SITES && n < max; i++) {
+        const char *function = __atomic_load_n(&sites[i].function, __ATOMIC_ACQUIRE);
+        uint32_t count = __atomic_load_n(&sites[i].count, __ATOMIC_RELAXED);
+        if (function != NULL && count != 0) {
+            out[n].function = function;
+            out[n].count = count;
+            n++;
+        }
+    }
+    return n;
+}
+
+uint32_t usbSerialJtag_traceEntries(__usbSerialJtag_traceEntry_t *out, uint32_t max)
+{
+    uint32_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+    uint32_t n = (h < USB_SERIAL_JTAG_CFG_TRACE_DEPTH) ? h : USB_SERIAL_JTAG_CFG_TRACE_DEPTH;
+
+    if (n > max) {
+        n = max;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = buffer[(h - n + i) & (kTRACE_BUFFER - 1U)];
+    }
+    return n;
+}
+
+void usbSerialJtag_traceDump(__usbSerialJtag_traceOut_t out, void *arg)
+{
+    uint32_t was = __atomic_exchange_n(&enabled, 0, __ATOMIC_RELAXED);
+    __usbSerialJtag_traceCount_t c;
+    char line[kTRACE_LINE];
+    uint32_t peak = 1;
+    uint32_t pos;
+
+    for (uint32_t i = 0; i < kUSB_SERIAL_JTAG_TRACE_REGS; i++) {
+        usbSerialJtag_traceCount(i, &c);
+        if (registerTotal(&c) > peak) {
+            peak = registerTotal(&c);
+        }
+    }
+
+    out("offset register             reads   writes     amos", arg);
+    for (uint32_t i = 0; i < kUSB_SERIAL_JTAG_TRACE_REGS; i++) {
+        usbSerialJtag_traceCount(i, &c);
+        uint32_t total = registerTotal(&c);
+        if (total == 0) {
+            continue;
+        }
+        pos = lineText(line, 0, "0x");
+        pos = lineNumber(line, pos, i * 4U, 16U, 3);
+        pos = lineText(line, pos, "  ");
+        pos = lineText(line, pos, names[i]);
+        while (pos < 25U) {
+            line[pos++] = ' ';
+        }
+        pos = lineNumber(line, pos, c.reads, 10U, 8);
+        pos = lineNumber(line, pos, c.writes, 10U, 9);
+        pos = lineNumber(line, pos, c.amos, 10U, 9);
+        pos = lineText(line, pos, " ");
+        for (uint32_t b = 0; b < (uint32_t) (((uint64_t) total * kTRACE_BAR + peak - 1U) / peak); b++) {
+            pos = lineText(line, pos, "#");
+        }
+        out(line, arg);
+    }
+
+    out("r/b macro accesses per function", arg);
+    for (uint32_t i = 0; i < USB_SERIAL_JTAG_CFG_TRACE_SITES; i++) {
+        const char *function = __atomic_load_n(&sites[i].function, __ATOMIC_ACQUIRE);
+        uint32_t count = __atomic_load_n(&sites[i].count, __ATOMIC_RELAXED);
+        if (function == NULL || count == 0) {
+            continue;
+        }
+        pos = lineNumber(line, 0, count, 10U, 10);
+        pos = lineText(line, pos, "  ");
+        lineText(line, pos, function);
+        out(line, arg);
+    }
+    if (sitesLost != 0) {
+        pos = lineNumber(line, 0, sitesLost, 10U, 10);
+        lineText(line, pos, "  (functions not tracked, table full)");
+        out(line, arg);
+    }
+
+    __atomic_store_n(&enabled, was, __ATOMIC_RELAXED);
+}
+
+void usbSerialJtag_traceAccess(uintptr_t addr, uint32_t value, uint32_t kind)
+{
+    uintptr_t offset = addr - (uintptr_t) kUSB_SERIAL_JTAG_BASE_ADDR;
+
+    if (!__atomic_load_n(&enabled, __ATOMIC_RELAXED) || offset >= kUSB_SERIAL_JTAG_TRACE_REGS * 4U) {
+        return;
+    }
+
+    __usbSerialJtag_traceCount_t *c = &counts[offset / 4U];
+    countAdd((kind == kUSB_SERIAL_JTAG_TRACE_READ) ? &c->reads : (kind == kUSB_SERIAL_JTAG_TRACE_WRITE) ? &c->writes : &c->amos);
+
+    if (USB_SERIAL_JTAG_CFG_TRACE_DEPTH != 0) {
+        uint32_t slot = __atomic_fetch_add(&head, 1U, __ATOMIC_RELAXED) & (kTRACE_BUFFER - 1U);
+        buffer[slot].cycles = usbSerialJtag_cycles();
+        buffer[slot].value = value;
+        buffer[slot].offset = (uint8_t) offset;
+        buffer[slot].kind = (uint8_t) kind;
+    }
+}
+
+void *usbSerialJtag_traceDirect(const char *function)
+{
+    if (__atomic_load_n(&enabled, __ATOMIC_RELAXED)) {
+        uint32_t key = (uint32_t) (uintptr_t) function;
+        uint32_t i = (key >> 2) * 2654435761U;
+
+        for (uint32_t probe = 0; probe < USB_SERIAL_JTAG_CFG_TRACE_SITES; probe++, i++) {
+            __usbSerialJtag_traceSite_t *site = &sites[i & (USB_SERIAL_JTAG_CFG_TRACE_SITES - 1U)];
+            const char *owner = __atomic_load_n(&site->function, __ATOMIC_ACQUIRE);
+            if (owner == NULL) {
+                // Claim the free slot, another context may claim it first for another function
+                __atomic_compare_exchange_n(&site->function, &owner, function, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+                if (owner == NULL) {
+                    owner = function;
+                }
+            }
+            if (owner == function) {
+                countAdd(&site->count);
+                return (void *) &sUSB_SERIAL_JTAG_MMIO;
+            }
+        }
+        countAdd(&sitesLost);
+    }
+    return (void *) &sUSB_SERIAL_JTAG_MMIO;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_TRACE.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Register access tracing and MMIO cost profiler of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates the profiling build mode of the register layer. With
+ * USB_SERIAL_JTAG_CFG_TRACE_ENABLE set to 1:
+ *
+ * - the snapshot, commit and modify helpers and the atomic write macros count their reads,
+ *   writes and AMOs per register word, and log them with a cycle stamp (mpccr) in a RAM trace
+ *   buffer of USB_SERIAL_JTAG_CFG_TRACE_DEPTH entries;
+ * - every expansion of sUSB_SERIAL_JTAG (all the r and b macros) is counted per calling
+ *   function. A bitfield macro is a volatile load, or a load and a store when it is assigned,
+ *   so a function with a high count is a candidate for a snapshot or a Modify.
+ *
+ * usbSerialJtag_traceDump prints the per-register histogram and the per-function table. The
+ * counters are updated with relaxed atomics from any context; the mode is meant for profiling
+ * builds only, each access costs a function call.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_TRACE_H
+#define USB_SERIAL_JTAG_ESP32_C6_TRACE_H
+
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+
+/**
+ * Constant definitions for the trace
+ */
+#define kUSB_SERIAL_JTAG_TRACE_REGS 33U // Register words from ep1Reg (0x00) to dateReg (0x80)
+
+#define kUSB_SERIAL_JTAG_TRACE_READ 0U // Access kinds
+#define kUSB_SERIAL_JTAG_TRACE_WRITE 1U
+#define kUSB_SERIAL_JTAG_TRACE_AMO 2U
+
+/**
+ * \typedef __usbSerialJtag_traceCount_t
+ * Accesses to one register word
+ */
+typedef struct {
+    uint32_t reads; // __usbSerialJtag_regRead (Snapshot, Modify)
+    uint32_t writes; // __usbSerialJtag_regWrite (Commit, Modify, WT set macros)
+    uint32_t amos; // set/clr/xor atomic macros
+} __usbSerialJtag_traceCount_t;
+
+/**
+ * \typedef __usbSerialJtag_traceEntry_t
+ * One entry of the RAM trace buffer
+ */
+typedef struct {
+    uint32_t cycles; // Cycle counter at the access
+    uint32_t value; // Value read or written, mask of an AMO
+    uint8_t offset; // Register offset from kUSB_SERIAL_JTAG_BASE_ADDR
+    uint8_t kind; // kUSB_SERIAL_JTAG_TRACE_READ/WRITE/AMO
+} __usbSerialJtag_traceEntry_t;
+
+/**
+ * \typedef __usbSerialJtag_traceSite_t
+ * r/b macro accesses of one function
+ */
+typedef struct {
+    const char *function; // __func__ of the caller
+    uint32_t count; // Expansions of sUSB_SERIAL_JTAG executed
+} __usbSerialJtag_traceSite_t;
+
+/**
+ * @brief Output of usbSerialJtag_traceDump, called once per line
+ */
+typedef void (*__usbSerialJtag_traceOut_t)(const char *line, void *arg);
+
+
+/**
+ * @brief Clear the counters, the sites and the trace buffer (the trace keeps its enable state)
+ */
+void usbSerialJtag_traceReset(void);
+
+/**
+ * @brief Start or stop the recording (recording at reset)
+ *
+ * @param enable 1 to record the accesses, 0 to ignore them
+ */
+void usbSerialJtag_traceEnable(uint32_t enable);
+
+/**
+ * @brief Get the counters of one register word
+ *
+ * @param index Register offset / 4, below kUSB_SERIAL_JTAG_TRACE_REGS
+ * @param out Copy of the counters
+ * @return int 0 on success, -1 if index is out of range
+ */
+int usbSerialJtag_traceCount(uint32_t index, __usbSerialJtag_traceCount_t *out);
+
+/**
+ * @brief Copy the per-function table of the r/b macro accesses
+ *
+ * @param out Sites, in table order
+ * @param max Number of entries of out
+ * @return uint32_t Number of sites copied
+ */
+uint32_t usbSerialJtag_traceSites(__usbSerialJtag_traceSite_t *out, uint32_t max);
+
+/**
+ * @brief Copy the most recent entries of the trace buffer, oldest first
+ *
+ * Stop the recording first, entries written during the copy may be torn.
+ *
+ * @param out Entries
+ * @param max Number of entries of out
+ * @return uint32_t Number of entries copied
+ */
+uint32_t usbSerialJtag_traceEntries(__usbSerialJtag_traceEntry_t *out, uint32_t max);
+
+/**
+ * @brief Print the per-register histogram and the per-function table
+ *
+ * The recording is paused during the dump, so the accesses of the output path are not counted.
+ *
+ * @param out Line output
+ * @param arg Argument passed to out
+ */
+void usbSerialJtag_traceDump(__usbSerialJtag_traceOut_t out, void *arg);
+
+/**
+ * @brief Record a register word access (called by the LIB.h helpers)
+ *
+ * @param addr Register address
+ * @param value Value read or written, mask of an AMO
+ * @param kind kUSB_SERIAL_JTAG_TRACE_READ/WRITE/AMO
+ */
+void usbSerialJtag_traceAccess(uintptr_t addr, uint32_t value, uint32_t kind);
+
+/**
+ * @brief Count an expansion of sUSB_SERIAL_JTAG (called by the LIB.h r/b macros)
+ *
+ * @param function __func__ of the caller
+ * @return void* Base address of the controller
+ */
+void *usbSerialJtag_traceDirect(const char *function);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_TRACE_H
\ No newline at end of file
@@ -0,0 +1,133 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_TXQ.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Scatter/gather TX descriptor queue for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ */
+
+#include "USB_SERIAL_JTAG_ESP32-C6_TXQ.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+
+_Static_assert((USB_SERIAL_JTAG_CFG_TXQ_DEPTH & (USB_SERIAL_JTAG_CFG_TXQ_DEPTH - 1U)) == 0, "TX descriptor queue depth must be a power of two");
+
+static __usbSerialJtag_txqDesc_t *queue[USB_SERIAL_JTAG_CFG_TXQ_DEPTH];
+static uint32_t head = 0; // Written by the producer
+static uint32_t tail = 0; // Written by the ISR
+
+// Position of the ISR inside the descriptor at the tail
+static uint32_t segIdx = 0;
+static uint32_t segOff = 0;
+
+
+/**
+ * @brief Length of the first segments of a descriptor
+ */
+static uint32_t txqTotal(const __usbSerialJtag_txqDesc_t *desc, uint32_t count)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += desc->segs[i].len;
+    }
+    return total;
+}
+
+void usbSerialJtag_txqInit(void)
+{
+    __atomic_store_n(&tail, __atomic_load_n(&head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    segIdx = 0;
+    segOff = 0;
+}
+
+int usbSerialJtag_txqSubmit(__usbSerialJtag_txqDesc_t *desc)
+{
+    uint32_t h = head;
+
+    if (h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) >= USB_SERIAL_JTAG_CFG_TXQ_DEPTH) {
+        return -1;
+    }
+    queue[h & (USB_SERIAL_JTAG_CFG_TXQ_DEPTH - 1U)] = desc;
+    __atomic_store_n(&head, h + 1U, __ATOMIC_RELEASE);
+
+    usbSerialJtag_isrKickTx();
+    return 0;
+}
+
+uint32_t usbSerialJtag_txqPending(void)
+{
+    return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+}
+
+uint32_t usbSerialJtag_txqBusy(void)
+{
+    return (segIdx != 0 || segOff != 0) ? 1U : 0U;
+}
+
+uint32_t usbSerialJtag_txqFill(__usbSerialJtag_t *hw, uint32_t space)
+{
+    uint32_t pushed = 0;
+    uint32_t t = tail;
+
+    while (pushed < space && t != __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        __usbSerialJtag_txqDesc_t *desc = queue[t & (USB_SERIAL_JTAG_CFG_TXQ_DEPTH - 1U)];
+
+        // Stream the segments straight from the application memory
+        while (pushed < space && segIdx < desc->count) {
+            const __usbSerialJtag_txqSeg_t *seg = &desc->segs[segIdx];
+            uint32_t n = seg->len - segOff;
+            if (n > space - pushed) {
+                n = space - pushed;
+            }
+            usbSerialJtag_txPush(hw, &seg->ptr[segOff], n);
+            pushed += n;
+            segOff += n;
+            if (segOff == seg->len) {
+                segIdx++;
+                segOff = 0;
+            }
+        }
+
+        if (segIdx < desc->count) {
+            break;
+        }
+
+        // Last byte is in the FIFO, the memory of the descriptor is released
+        segIdx = 0;
+        t++;
+        __atomic_store_n(&tail, t, __ATOMIC_RELEASE);
+        desc->sent = txqTotal(desc, desc->count);
+        if (desc->done != NULL) {
+            desc->done(desc, desc->arg, kUSB_SERIAL_JTAG_TXQ_SENT);
+        }
+    }
+
+    return pushed;
+}
+
+void usbSerialJtag_txqFlush(void)
+{
+    uint32_t t = tail;
+    uint32_t sent = 0;
+
+    if (t != __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        // Only the descriptor at the tail can be partially pushed
+        sent = txqTotal(queue[t & (USB_SERIAL_JTAG_CFG_TXQ_DEPTH - 1U)], segIdx) + segOff;
+    }
+    segIdx = 0;
+    segOff = 0;
+    while (t != __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        __usbSerialJtag_txqDesc_t *desc = queue[t & (USB_SERIAL_JTAG_CFG_TXQ_DEPTH - 1U)];
+        t++;
+        __atomic_store_n(&tail, t, __ATOMIC_RELEASE);
+        desc->sent = sent;
+        sent = 0;
+        if (desc->done != NULL) {
+            desc->done(desc, desc->arg, kUSB_SERIAL_JTAG_TXQ_CANCELLED);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file USB_SERIAL_JTAG_ESP32-C6_TXQ.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Scatter/gather TX descriptor queue for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates a zero-copy transmit queue for the CDC-ACM IN endpoint. A descriptor
+ * holds a list of {ptr,len} segments that are streamed straight from the application memory into
+ * the EP1 FIFO by the SERIAL_IN_EMPTY_INT handler of the interrupt driver. The memory of the
+ * segments and of the descriptor must stay valid until the completion callback is called.
+ *
+ * The queue is serviced by usbSerialJtag_isrHandler when USB_SERIAL_JTAG_CFG_TXQ_ENABLE is 1. A
+ * descriptor is always sent whole, the bytes of the TX ring are sent in between descriptors.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_ESP32_C6_TXQ_H
+#define USB_SERIAL_JTAG_ESP32_C6_TXQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+
+/**
+ * \typedef __usbSerialJtag_txqSeg_t
+ * Segment of a TX descriptor
+ */
+typedef struct {
+    const uint8_t *ptr; // Start of the segment
+    uint32_t len; // Length of the segment in bytes
+} __usbSerialJtag_txqSeg_t;
+
+/**
+ * Completion status of a TX descriptor
+ */
+#define kUSB_SERIAL_JTAG_TXQ_SENT 0U // Every byte is in the FIFO
+#define kUSB_SERIAL_JTAG_TXQ_CANCELLED 1U // Dropped by usbSerialJtag_txqFlush, sent holds the bytes pushed before
+
+typedef struct __usbSerialJtag_txqDesc __usbSerialJtag_txqDesc_t;
+
+/**
+ * \typedef __usbSerialJtag_txqCallback_t
+ * Completion callback of a TX descriptor, called from the ISR once its last byte is in the FIFO or
+ * once it is dropped
+ */
+typedef void (*__usbSerialJtag_txqCallback_t)(__usbSerialJtag_txqDesc_t *desc, void *arg, uint32_t status);
+
+/**
+ * \typedef __usbSerialJtag_txqDesc_t
+ * TX descriptor
+ */
+struct __usbSerialJtag_txqDesc {
+    const __usbSerialJtag_txqSeg_t *segs; // Segment list
+    uint32_t count; // Number of segments
+    __usbSerialJtag_txqCallback_t done; // Completion callback (can be NULL)
+    void *arg; // Argument of the completion callback
+    uint32_t sent; // Bytes pushed to the FIFO, set by the ISR before the completion callback
+};
+
+
+/**
+ * @brief Reset the descriptor queue, the queued descriptors are dropped without completion
+ */
+void usbSerialJtag_txqInit(void);
+
+/**
+ * @brief Queue a descriptor for transmission (single producer)
+ *
+ * @param desc Descriptor to be sent, owned by the queue until its completion callback
+ * @return int 0 on success, -1 if the queue is full
+ */
+int usbSerialJtag_txqSubmit(__usbSerialJtag_txqDesc_t *desc);
+
+/**
+ * @brief Number of descriptors queued or in progress
+ */
+uint32_t usbSerialJtag_txqPending(void);
+
+/**
+ * @brief Whether a descriptor is partially pushed to the FIFO (ISR side)
+ */
+uint32_t usbSerialJtag_txqBusy(void);
+
+/**
+ * @brief Complete the queued descriptors with kUSB_SERIAL_JTAG_TXQ_CANCELLED, without sending the
+ * rest of their data (ISR side)
+ */
+void usbSerialJtag_txqFlush(void);
+
+/**
+ * @brief Push the queued descriptors to the FIFO (ISR side)
+ *
+ * The bytes are pushed without committing the packet, the caller issues WR_DONE.
+ *
+ * @param hw Register block
+ * @param space Free space of the FIFO
+ * @return uint32_t Number of bytes pushed
+ */
+uint32_t usbSerialJtag_txqFill(__usbSerialJtag_t *hw, uint32_t space);
+
+#endif // USB_SERIAL_JTAG_ESP32_C6_TXQ_H
\ No newline at end of file
@@ -0,0 +1,304 @@
+/**
+ * @file usb_serial_jtag_bench.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Throughput and latency benchmark firmware for the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This file is the device side of the benchmark driven by usb_serial_jtag_bench.py. Build it with
+ * the driver sources and call usbSerialJtag_benchRun from the application entry point. For the ISR
+ * path the application also routes the USB Serial JTAG interrupt to usbSerialJtag_isrHandler.
+ *
+ * The time base is the SOF frame index of framNumReg (1 ms per frame at Full-Speed).
+ *
+ * Protocol (host to device), a command is 8 bytes:
+ *
+ *     'U' 'B' CMD PATH SIZE 0 FRAMES_LO FRAMES_HI
+ *
+ * CMD   'I' IN throughput: the device sends SIZE-byte writes during FRAMES frames, then a report
+ *       'O' OUT throughput: the device drains the OUT endpoint until it is idle for FRAMES frames,
+ *           then sends a report
+ *       'E' Echo: the device echoes every received chunk until it is idle for FRAMES frames
+ * PATH  'B' byte loop (one status read and one WR_DONE per byte)
+ *       'K' bulk (usbSerialJtag_write/usbSerialJtag_read)
+ *       'R' ISR rings (usbSerialJtag_isrWrite/usbSerialJtag_isrRead)
+ *
+ * Report (device to host), 20 bytes little endian:
+ *
+ *     'U' 'B' 'R' CMD, bytes (u32), packets (u32), frames (u32), max packets in one frame (u32)
+ *
+ * The packets are the WR_DONE commits (IN) and the OUT packets drained. The 'R' path moves them in
+ * the ISR, they are taken from the statistics block (0 unless USB_SERIAL_JTAG_CFG_STATS_ENABLE is
+ * 1); the OUT packets of the 'B' path are not counted.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+#include "USB_SERIAL_JTAG_ESP32-C6_STATS.h"
+#endif
+
+#define kBENCH_CMD_SIZE 8U
+#define kBENCH_REPORT_SIZE 20U
+#define kBENCH_DRAIN_CYCLES ((uint32_t) (100U * kUSB_SERIAL_JTAG_CYCLES_PER_MS)) // Wait for the host to read the TX ring at the end of an 'R' run
+
+/**
+ * \typedef __benchResult_t
+ * Counters of one benchmark run
+ */
+typedef struct {
+    uint32_t bytes; // Payload bytes moved
+    uint32_t packets; // WR_DONE count (IN) or packets drained (OUT)
+    uint32_t frames; // Elapsed SOF frames
+    uint32_t maxPerFrame; // Max packets committed in a single frame
+    uint32_t curFrame; // Frame index of the last sample
+    uint32_t curCount; // Packets committed in curFrame
+    uint32_t lastPackets; // Packet counter of the path at the last sample (benchPathPackets)
+} __benchResult_t;
+
+static uint8_t pattern[kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE];
+static uint8_t scratch[256];
+
+
+static uint32_t frameIndex(void)
+{
+    return usbSerialJtag_framNumSnapshot().BITS.SOF_FRAME_INDEX;
+}
+
+/**
+ * @brief Advance the frame counter of a run, the 11-bit index wraps every 2048 ms
+ */
+static void benchTick(__benchResult_t *res)
+{
+    uint32_t now = frameIndex();
+    uint32_t delta = (now - res->curFrame) & mUSBSERIALJTAG_FRAMNUMREG_SOF_FRAME_INDEX;
+
+    if (delta != 0) {
+        res->frames += delta;
+        res->curFrame = now;
+        res->curCount = 0;
+    }
+}
+
+static void benchCountPackets(__benchResult_t *res, uint32_t packets)
+{
+    res->packets += packets;
+    res->curCount += packets;
+    if (res->curCount > res->maxPerFrame) {
+        res->maxPerFrame = res->curCount;
+    }
+}
+
+/**
+ * @brief Packets moved by the 'R' path (IN and OUT) or the 'K' path (OUT) since the last sample
+ *
+ * @param in 1 for the WR_DONE commits, 0 for the OUT packets
+ */
+static uint32_t benchPathPackets(uint8_t path, uint32_t in, __benchResult_t *res)
+{
+    uint32_t now = 0;
+
+    if (path == 'R') {
+#if USB_SERIAL_JTAG_CFG_STATS_ENABLE
+        __usbSerialJtag_stats_t st;
+        usbSerialJtag_statsSnapshot(&st);
+        now = in ? st.ep1InPackets : st.ep1OutPackets;
+#endif
+    } else if (path == 'K' && !in) {
+        now = usbSerialJtag_rxPacketCount();
+    } else {
+        return 0;
+    }
+
+    uint32_t delta = now - res->lastPackets;
+    res->lastPackets = now;
+    return delta;
+}
+
+static size_t pathWrite(uint8_t path, const uint8_t *buf, size_t len, __benchResult_t *res)
+{
+    size_t done = 0;
+
+    if (path == 'B') {
+        // Reference path: one status read and one WR_DONE per byte
+        while (done < len && bUSB_SERIAL_JTAG_SERIAL_IN_EP_DATA_FREE) {
+            pushUSB_SERIAL_JTAG_EP1(buf[done++]);
+            bUSB_SERIAL_JTAG_WR_DONE = 1;
+            benchCountPackets(res, 1);
+        }
+    } else if (path == 'K') {
+        done = usbSerialJtag_write(usbSerialJtag_hw(), buf, len);
+        benchCountPackets(res, (uint32_t) ((done + kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE - 1U) / kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE));
+    } else {
+        // Committed by the ISR, counted by benchPathPackets
+        done = usbSerialJtag_isrWrite(buf, len);
+    }
+    return done;
+}
+
+static size_t pathRead(uint8_t path, uint8_t *buf, size_t max)
+{
+    size_t got = 0;
+
+    if (path == 'B') {
+        while (got < max && bUSB_SERIAL_JTAG_SERIAL_OUT_EP_DATA_AVAIL) {
+            buf[got++] = (uint8_t) popUSB_SERIAL_JTAG_EP1();
+        }
+    } else if (path == 'K') {
+        got = usbSerialJtag_read(usbSerialJtag_hw(), buf, max);
+    } else {
+        got = usbSerialJtag_isrRead(buf, max);
+    }
+    return got;
+}
+
+static void pathWriteAll(uint8_t path, const uint8_t *buf, size_t len, __benchResult_t *res)
+{
+    size_t done = 0;
+
+    while (done < len) {
+        done += pathWrite(path, &buf[done], len - done, res);
+    }
+}
+
+static void put32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t) value;
+    dst[1] = (uint8_t) (value >> 8);
+    dst[2] = (uint8_t) (value >> 16);
+    dst[3] = (uint8_t) (value >> 24);
+}
+
+static void benchReport(uint8_t cmd, const __benchResult_t *res)
+{
+    uint8_t report[kBENCH_REPORT_SIZE] = { 'U', 'B', 'R', cmd };
+    __benchResult_t ignore = { 0 };
+
+    put32(&report[4], res->bytes);
+    put32(&report[8], res->packets);
+    put32(&report[12], res->frames);
+    put32(&report[16], res->maxPerFrame);
+    pathWriteAll('K', report, sizeof(report), &ignore);
+}
+
+static void benchIn(uint8_t path, uint32_t size, uint32_t frames)
+{
+    __benchResult_t res = { .curFrame = frameIndex() };
+
+    (void) benchPathPackets(path, 1, &res);
+    while (res.frames < frames) {
+        res.bytes += (uint32_t) pathWrite(path, pattern, size, &res);
+        benchCountPackets(&res, benchPathPackets(path, 1, &res));
+        benchTick(&res);
+    }
+    if (path == 'R') {
+        // The ISR sends the rest of the ring, unless the host stopped reading
+        uint32_t start = usbSerialJtag_cycles();
+        while (usbSerialJtag_isrTxPending() != 0 && usbSerialJtag_cycles() - start < kBENCH_DRAIN_CYCLES) {
+        }
+        benchCountPackets(&res, benchPathPackets(path, 1, &res));
+        benchTick(&res);
+        res.bytes -= usbSerialJtag_isrTxPending();
+        usbSerialJtag_isrDeinit();
+    }
+    benchReport('I', &res);
+}
+
+static void benchOut(uint8_t path, uint32_t idleFrames, uint32_t echo)
+{
+    __benchResult_t res = { .curFrame = frameIndex() };
+    __benchResult_t ignore = { 0 };
+    uint32_t idle = 0;
+    uint32_t started = 0;
+
+    (void) benchPathPackets(path, 0, &res);
+    while (idle < idleFrames) {
+        size_t got = pathRead(path, scratch, sizeof(scratch));
+        uint32_t before = res.frames;
+        benchTick(&res);
+
+        if (got != 0) {
+            if (!started) {
+                // The run starts with the first byte, not with the command
+                res.frames = 0;
+                started = 1;
+            }
+            res.bytes += (uint32_t) got;
+            benchCountPackets(&res, benchPathPackets(path, 0, &res));
+            idle = 0;
+            if (echo) {
+                pathWriteAll(path, scratch, got, &ignore);
+            }
+        } else {
+            idle += res.frames - before;
+        }
+    }
+    res.frames -= idle;
+    if (path == 'R') {
+        usbSerialJtag_isrDeinit();
+    }
+    benchReport(echo ? 'E' : 'O', &res);
+}
+
+
+/**
+ * @brief Benchmark command loop, never returns
+ */
+void usbSerialJtag_benchRun(void)
+{
+    uint8_t cmd[kBENCH_CMD_SIZE];
+    uint32_t have = 0;
+
+    for (uint32_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t) ('0' + (i % 64U));
+    }
+
+    for (;;) {
+        have += (uint32_t) usbSerialJtag_read(usbSerialJtag_hw(), &cmd[have], 1);
+        if (have == 1 && cmd[0] != 'U') {
+            have = 0;
+            continue;
+        }
+        if (have < kBENCH_CMD_SIZE) {
+            continue;
+        }
+        have = 0;
+        if (cmd[1] != 'B') {
+            continue;
+        }
+
+        uint8_t path = cmd[3];
+        uint32_t size = cmd[4];
+        uint32_t frames = (uint32_t) cmd[6] | ((uint32_t) cmd[7] << 8);
+        if (size == 0 || size > kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE) {
+            size = kUSB_SERIAL_JTAG_EP1_MAX_PACKET_SIZE;
+        }
+
+        // The ISR only owns the FIFO during an 'R' run, commands and reports use the bulk path
+        if (path == 'R') {
+            usbSerialJtag_isrInit();
+        }
+
+        switch (cmd[2]) {
+            case 'I':
+                benchIn(path, size, frames);
+                break;
+            case 'O':
+                benchOut(path, frames, 0);
+                break;
+            case 'E':
+                benchOut(path, frames, 1);
+                break;
+            default:
+                break;
+        }
+    }
+}
\ No newline at end of file
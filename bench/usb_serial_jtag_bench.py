@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Host side of the ESP32-C6 USB Serial JTAG benchmark (see usb_serial_jtag_bench.c).
+
+Measures, for every path (byte loop, bulk, ISR rings) and packet size:
+
+* sustained IN throughput (device to host)
+* sustained OUT throughput (host to device)
+* round-trip echo latency
+* packets committed per SOF frame
+
+The device reports its own byte, packet and SOF frame counters; the host adds wall-clock timing.
+
+Usage:
+    usb_serial_jtag_bench.py /dev/ttyACM0 [--paths BKR] [--sizes 1,8,64] [--frames 1000]
+                             [--csv out.csv] [--baseline old.csv --tolerance 0.1]
+
+With --baseline the run fails (exit code 1) when a throughput drops more than --tolerance
+against the baseline CSV, so the script can gate driver changes.
+"""
+
+import argparse
+import csv
+import statistics
+import struct
+import sys
+import time
+
+try:
+    import serial
+except ImportError:  # pragma: no cover
+    sys.exit("pyserial is required: pip install pyserial")
+
+REPORT_SIZE = 20
+PATHS = {"B": "byte loop", "K": "bulk", "R": "ISR rings"}
+DEFAULT_SIZES = [1, 2, 4, 8, 16, 32, 48, 63, 64]
+
+
+def command(cmd, path, size, frames):
+    return struct.pack("<2sccBBH", b"UB", cmd.encode(), path.encode(), size, 0, frames)
+
+
+def read_until_idle(port, idle=0.2):
+    """Read everything the device sends until the line is idle for `idle` seconds."""
+    data = bytearray()
+    last = time.monotonic()
+    while time.monotonic() - last < idle:
+        chunk = port.read(port.in_waiting or 1)
+        if chunk:
+            data += chunk
+            last = time.monotonic()
+    return bytes(data)
+
+
+def parse_report(data, cmd):
+    if len(data) < REPORT_SIZE:
+        raise RuntimeError("no report from the device")
+    report = data[-REPORT_SIZE:]
+    magic, rcmd, nbytes, packets, frames, max_per_frame = struct.unpack("<3sc4I", report)
+    if magic != b"UBR" or rcmd != cmd.encode():
+        raise RuntimeError("bad report %r" % report)
+    return {"bytes": nbytes, "packets": packets, "frames": frames, "max_per_frame": max_per_frame}
+
+
+def rate(nbytes, frames):
+    """Bytes per second on the SOF 1 ms time base."""
+    return nbytes * 1000.0 / frames if frames else 0.0
+
+
+def bench_in(port, path, size, frames):
+    port.reset_input_buffer()
+    start = time.monotonic()
+    port.write(command("I", path, size, frames))
+    data = read_until_idle(port)
+    wall = time.monotonic() - start
+    rep = parse_report(data, "I")
+    received = len(data) - REPORT_SIZE
+    if received != rep["bytes"]:
+        print("  warning: host got %d bytes, device sent %d" % (received, rep["bytes"]), file=sys.stderr)
+    return {
+        "in_Bps": rate(rep["bytes"], rep["frames"]),
+        "in_wall_Bps": received / wall if wall else 0.0,
+        "in_pkt_per_frame": rep["packets"] / rep["frames"] if rep["frames"] else 0.0,
+        "in_max_pkt_per_frame": rep["max_per_frame"],
+    }
+
+
+def bench_out(port, path, size, frames, duration=1.0):
+    port.reset_input_buffer()
+    port.write(command("O", path, size, 50))
+    time.sleep(0.05)
+    chunk = bytes(range(size)) * max(1, 4096 // size)
+    sent = 0
+    end = time.monotonic() + duration
+    while time.monotonic() < end:
+        sent += port.write(chunk)
+    port.flush()
+    rep = parse_report(read_until_idle(port, 0.5), "O")
+    if rep["bytes"] != sent:
+        print("  warning: host sent %d bytes, device got %d" % (sent, rep["bytes"]), file=sys.stderr)
+    return {"out_Bps": rate(rep["bytes"], rep["frames"])}
+
+
+def bench_echo(port, path, size, rounds=200):
+    port.reset_input_buffer()
+    port.write(command("E", path, size, 200))
+    time.sleep(0.05)
+    payload = bytes((i & 0xFF) for i in range(size))
+    samples = []
+    for _ in range(rounds):
+        start = time.perf_counter()
+        port.write(payload)
+        got = bytearray()
+        while len(got) < size:
+            got += port.read(size - len(got))
+        samples.append((time.perf_counter() - start) * 1e6)
+    read_until_idle(port, 0.5)
+    samples.sort()
+    return {
+        "echo_p50_us": statistics.median(samples),
+        "echo_p99_us": samples[int(len(samples) * 0.99) - 1],
+    }
+
+
+def load_baseline(path):
+    with open(path, newline="") as f:
+        return {(row["path"], int(row["size"])): row for row in csv.DictReader(f)}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("port")
+    ap.add_argument("--paths", default="BKR")
+    ap.add_argument("--sizes", default=",".join(map(str, DEFAULT_SIZES)))
+    ap.add_argument("--frames", type=int, default=1000, help="length of an IN run in SOF frames")
+    ap.add_argument("--csv")
+    ap.add_argument("--baseline")
+    ap.add_argument("--tolerance", type=float, default=0.10)
+    args = ap.parse_args()
+
+    sizes = [int(s) for s in args.sizes.split(",")]
+    rows = []
+    with serial.Serial(args.port, timeout=0.05) as port:
+        for path in args.paths:
+            for size in sizes:
+                row = {"path": path, "size": size}
+                row.update(bench_in(port, path, size, args.frames))
+                row.update(bench_out(port, path, size, args.frames))
+                row.update(bench_echo(port, path, size))
+                rows.append(row)
+                print("%-9s %2d B  IN %8.0f B/s (%.2f pkt/frame, max %d)  OUT %8.0f B/s  echo p50 %6.0f us p99 %6.0f us" % (
+                    PATHS.get(path, path), size, row["in_Bps"], row["in_pkt_per_frame"], row["in_max_pkt_per_frame"],
+                    row["out_Bps"], row["echo_p50_us"], row["echo_p99_us"]))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+            writer.writeheader()
+            writer.writerows(rows)
+
+    if args.baseline:
+        base = load_baseline(args.baseline)
+        failed = False
+        for row in rows:
+            old = base.get((row["path"], row["size"]))
+            if old is None:
+                continue
+            for key in ("in_Bps", "out_Bps"):
+                if row[key] < float(old[key]) * (1.0 - args.tolerance):
+                    print("REGRESSION %s %d B %s: %.0f -> %.0f" % (row["path"], row["size"], key, float(old[key]), row[key]))
+                    failed = True
+        return 1 if failed else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,397 @@
+/**
+ * @file usb_serial_jtag_sim.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Host register model of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * usbSerialJtag_simRegs is the memory seen by the driver. Every entry of the model first applies
+ * the WT bits written by the r/b macros (sync), then rewrites the RO registers from the model
+ * state (refresh). The model is single threaded, the ISR is called from
+ * the register writes and the host functions, never from inside another ISR call.
+ *
+ */
+
+#include <stddef.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_LIB.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_PORT.h"
+#include "usb_serial_jtag_sim.h"
+
+#if !USB_SERIAL_JTAG_CFG_SIM_ENABLE
+#error "Build the register model with USB_SERIAL_JTAG_CFG_SIM_ENABLE=1"
+#endif
+
+#define kSIM_FIFO_SIZE 64U
+#define kSIM_ACCESS_CYCLES 4U // Virtual cycles taken by a register access (APB round trip)
+#define kSIM_STORM 256U // ISR calls of one dispatch before INT_ST is considered stuck
+#define mSIM_SELF_SET mUSBSERIALJTAG_INTSTATUSREG_IN_EMPTY_INT // RAW bits set again while their condition holds
+
+__usbSerialJtag_t usbSerialJtag_simRegs;
+
+static __usbSerialJtag_t *const regs = &usbSerialJtag_simRegs;
+static __usbSerialJtag_simStats_t stats;
+static void (*isrHandler)(void) = NULL;
+static uint32_t inIsr = 0;
+
+static uint8_t inFifo[kSIM_FIFO_SIZE];
+static uint32_t inCount = 0; // Bytes written to the IN FIFO
+static uint32_t inBusy = 0; // WR_DONE written, packet waiting for the host
+static uint32_t inWr = 0; // IN_EPX_WR_ADDR
+static uint32_t inRd = 0; // IN_EPX_RD_ADDR
+
+static uint8_t outFifo[kSIM_FIFO_SIZE];
+static uint32_t outCount = 0; // Length of the OUT packet in the FIFO
+static uint32_t outPos = 0; // Bytes of the OUT packet read by the driver
+static uint32_t outWr = 0; // OUT_EPX_WR_ADDR
+static uint32_t outRd = 0; // OUT_EPX_RD_ADDR
+
+static uint32_t raw = 0; // Interrupt RAW bits
+static uint32_t frame = 0;
+static uint32_t cycles = 0;
+static uint32_t lineW0 = 0; // SET_LINE_CODING
+static uint32_t lineW1 = 0;
+static uint32_t control = 0; // JTAG_RTS | JTAG_DTR
+
+
+static void inPush(uint8_t byte)
+{
+    if (inBusy || inCount >= kSIM_FIFO_SIZE) {
+        stats.inOverflow++;
+        return;
+    }
+    inFifo[inCount++] = byte;
+    inWr = (inWr + 1U) & kUSB_SERIAL_JTAG_EP_ADDR_MASK;
+}
+
+static uint8_t outPop(void)
+{
+    if (outPos >= outCount) {
+        stats.outUnderflow++;
+        return 0;
+    }
+    outRd = (outRd + 1U) & kUSB_SERIAL_JTAG_EP_ADDR_MASK;
+    return outFifo[outPos++];
+}
+
+static void inCommit(void)
+{
+    stats.wrDone++;
+    if (!inBusy) {
+        inBusy = 1;
+    }
+}
+
+/**
+ * @brief Rewrite the RO registers and bits from the model state
+ *
+ * @param hold RAW bits just cleared by software, not set again by this refresh
+ */
+static void refresh(uint32_t hold)
+{
+    uint32_t conf = 0;
+
+    if (!inBusy && inCount < kSIM_FIFO_SIZE) {
+        conf |= mUSBSERIALJTAG_EP1CONFREG_SERIAL_IN_EP_DATA_FREE;
+    }
+    if (outPos < outCount) {
+        conf |= mUSBSERIALJTAG_EP1CONFREG_SERIAL_OUT_EP_DATA_AVAIL;
+    }
+    if (!inBusy && inCount == 0) {
+        raw |= mSIM_SELF_SET & ~hold;
+    }
+
+    regs->ep1ConfReg.WORD = conf;
+    regs->intRawReg.WORD = raw;
+    regs->intStReg.WORD = raw & regs->intEnaReg.WORD;
+    regs->intClrReg.WORD = 0;
+    regs->configUpdateReg.WORD = 0;
+    regs->framNumReg.WORD = frame & mUSBSERIALJTAG_FRAMNUMREG_SOF_FRAME_INDEX;
+    regs->inEp1StReg.WORD = usbSerialJtag_fieldSet(usbSerialJtag_fieldSet(mUSBSERIALJTAG_INEPXSTREG_RESET,
+        mUSBSERIALJTAG_INEPXSTREG_IN_EPX_WR_ADDR, inWr), mUSBSERIALJTAG_INEPXSTREG_IN_EPX_RD_ADDR, inRd);
+    regs->outEp1StReg.WORD = usbSerialJtag_fieldSet(usbSerialJtag_fieldSet(usbSerialJtag_fieldSet(mUSBSERIALJTAG_OUTEPXSTREG_RESET,
+        mUSBSERIALJTAG_OUTEPXSTREG_OUT_EPX_WR_ADDR, outWr), mUSBSERIALJTAG_OUTEPXSTREG_OUT_EPX_RD_ADDR, outRd),
+        mUSBSERIALJTAG_OUTEPXSTREG_EP1_REC_DATA_CNT, outCount);
+    regs->inEp0StReg.WORD = mUSBSERIALJTAG_INEPXSTREG_RESET;
+    regs->inEp2StReg.WORD = mUSBSERIALJTAG_INEPXSTREG_RESET;
+    regs->inEp3StReg.WORD = mUSBSERIALJTAG_INEPXSTREG_RESET;
+    regs->outEp0StReg.WORD = mUSBSERIALJTAG_OUTEPXSTREG_RESET;
+    regs->outEp2StReg.WORD = mUSBSERIALJTAG_OUTEPXSTREG_RESET;
+    regs->chipRstReg.WORD = (regs->chipRstReg.WORD & mUSBSERIALJTAG_CHIPRSTREG_USB_UART_CHIP_RST_DIS) | control;
+    regs->setLineCodeW0Reg.WORD = lineW0;
+    regs->setLineCodeW1Reg.WORD = lineW1;
+    regs->busResetStReg.WORD = mUSBSERIALJTAG_BUSRESETSTREG_RESET;
+    regs->dateReg.WORD = mUSBSERIALJTAG_DATEREG_RESET;
+}
+
+/**
+ * @brief Apply the accesses done by the r/b macros since the last entry
+ */
+static void sync(void)
+{
+    uint32_t clr = regs->intClrReg.WORD;
+
+    stats.accesses++;
+    cycles += kSIM_ACCESS_CYCLES;
+    if ((regs->ep1ConfReg.WORD & mUSBSERIALJTAG_EP1CONFREG_WR_DONE) != 0) {
+        inCommit();
+    }
+    if (regs->configUpdateReg.WORD != 0) {
+        stats.configUpdates++;
+    }
+    raw &= ~clr;
+    refresh(clr);
+}
+
+/**
+ * @brief Call the ISR while an enabled interrupt is pending (level triggered)
+ */
+static void dispatch(void)
+{
+    uint32_t calls = 0;
+
+    if (isrHandler == NULL || inIsr) {
+        return;
+    }
+    inIsr = 1;
+    while ((regs->intStReg.WORD) != 0) {
+        if (calls++ == kSIM_STORM) {
+            stats.irqStorms++;
+            break;
+        }
+        stats.isrCalls++;
+        isrHandler();
+        sync();
+    }
+    inIsr = 0;
+}
+
+/**
+ * @brief Handle a word write to a register (helpers and atomic macros)
+ */
+static void writeWord(volatile uint32_t *reg, uint32_t value)
+{
+    uint32_t hold = 0;
+
+    if (reg == &regs->ep1Reg.WORD) {
+        inPush((uint8_t) value);
+    } else if (reg == &regs->ep1ConfReg.WORD) {
+        if ((value & mUSBSERIALJTAG_EP1CONFREG_WR_DONE) != 0) {
+            inCommit();
+        }
+    } else if (reg == &regs->intRawReg.WORD || reg == &regs->intClrReg.WORD) {
+        raw &= ~value;
+        hold = value;
+    } else if (reg == &regs->configUpdateReg.WORD) {
+        if (value != 0) {
+            stats.configUpdates++;
+        }
+    } else if (reg == &regs->intStReg.WORD || reg == &regs->framNumReg.WORD || reg == &regs->setLineCodeW0Reg.WORD ||
+               reg == &regs->setLineCodeW1Reg.WORD || reg == &regs->busResetStReg.WORD || reg == &regs->dateReg.WORD ||
+               (reg >= &regs->inEp0StReg.WORD && reg <= &regs->outEp2StReg.WORD) || (reg >= &regs->RESERVED_0[0] && reg <= &regs->RESERVED_0[4])) {
+        // RO, the write is ignored
+    } else {
+        *reg = value;
+    }
+    refresh(hold);
+}
+
+
+void usbSerialJtag_simReset(void)
+{
+    __usbSerialJtag_simStats_t zero = { 0 };
+
+    stats = zero;
+    isrHandler = NULL;
+    inIsr = 0;
+    inCount = inBusy = inWr = inRd = 0;
+    outCount = outPos = outWr = outRd = 0;
+    frame = cycles = 0;
+    lineW0 = lineW1 = control = 0;
+    raw = mUSBSERIALJTAG_INTSTATUSREG_RESET_RAW;
+
+    regs->ep1Reg.WORD = mUSBSERIALJTAG_EP1REG_RESET;
+    regs->intEnaReg.WORD = mUSBSERIALJTAG_INTSTATUSREG_RESET_ENA;
+    regs->intClrReg.WORD = mUSBSERIALJTAG_INTSTATUSREG_RESET_CLR;
+    regs->conf0Reg.WORD = mUSBSERIALJTAG_CONF0REG_RESET;
+    regs->testReg.WORD = mUSBSERIALJTAG_TESTREG_RESET;
+    regs->jfifoStReg.WORD = mUSBSERIALJTAG_JFIFOSTREG_RESET;
+    regs->miscConfReg.WORD = mUSBSERIALJTAG_MISCCONFREG_RESET;
+    regs->memConfReg.WORD = mUSBSERIALJTAG_MEMCONFREG_RESET;
+    regs->chipRstReg.WORD = mUSBSERIALJTAG_CHIPRSTREG_RESET;
+    regs->getLineCodeW0Reg.WORD = mUSBSERIALJTAG_GETLINECODEW0REG_RESET;
+    regs->getLineCodeW1Reg.WORD = mUSBSERIALJTAG_GETLINECODEW1REG_RESET;
+    regs->configUpdateReg.WORD = mUSBSERIALJTAG_CONFIGUPDATEREG_RESET;
+    regs->serAfifoConficReg.WORD = mUSBSERIALJTAG_SERAFIFOCONFICREG_RESET;
+    refresh(0);
+}
+
+void usbSerialJtag_simSetIsr(void (*isr)(void))
+{
+    isrHandler = isr;
+    dispatch();
+}
+
+void usbSerialJtag_simPoll(void)
+{
+    sync();
+    dispatch();
+}
+
+int usbSerialJtag_simHostIn(uint8_t *buf, uint32_t max)
+{
+    int len = -1;
+
+    sync();
+    raw |= mUSBSERIALJTAG_INTSTATUSREG_IN_TOKEN_REC_IN_EP1_INT;
+    if (inBusy) {
+        for (uint32_t i = 0; i < inCount && i < max; i++) {
+            buf[i] = inFifo[i];
+        }
+        len = (int) ((inCount < max) ? inCount : max);
+        stats.inPackets++;
+        stats.inBytes += inCount;
+        inCount = 0;
+        inBusy = 0;
+        inRd = inWr;
+    } else {
+        stats.inNaks++;
+    }
+    refresh(0);
+    dispatch();
+    return len;
+}
+
+int usbSerialJtag_simHostOut(const uint8_t *buf, uint32_t len)
+{
+    sync();
+    if (outPos < outCount || len > kSIM_FIFO_SIZE) {
+        stats.outNaks++;
+        return -1;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        outFifo[i] = buf[i];
+    }
+    outCount = len;
+    outPos = 0;
+    outWr = (outWr + len) & kUSB_SERIAL_JTAG_EP_ADDR_MASK;
+    stats.outPackets++;
+    stats.outBytes += len;
+    raw |= (len != 0) ? mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT : mUSBSERIALJTAG_INTSTATUSREG_OUT_EP1_ZERO_PAYLOAD_INT;
+    refresh(0);
+    dispatch();
+    return 0;
+}
+
+void usbSerialJtag_simHostSof(void)
+{
+    sync();
+    frame = (frame + 1U) & mUSBSERIALJTAG_FRAMNUMREG_SOF_FRAME_INDEX;
+    cycles += (uint32_t) kUSB_SERIAL_JTAG_CYCLES_PER_MS;
+    raw |= mUSBSERIALJTAG_INTSTATUSREG_SOF_INT;
+    refresh(0);
+    dispatch();
+}
+
+void usbSerialJtag_simHostSetLine(uint32_t dteRate, uint8_t charFormat, uint8_t parityType, uint8_t dataBits)
+{
+    sync();
+    lineW0 = dteRate;
+    lineW1 = (uint32_t) charFormat | ((uint32_t) parityType << 8) | ((uint32_t) dataBits << 16);
+    raw |= mUSBSERIALJTAG_INTSTATUSREG_SET_LINE_CODE_INT;
+    refresh(0);
+    dispatch();
+}
+
+void usbSerialJtag_simHostGetLine(uint32_t *w0, uint32_t *w1)
+{
+    sync();
+    *w0 = regs->getLineCodeW0Reg.WORD;
+    *w1 = regs->getLineCodeW1Reg.WORD;
+    raw |= mUSBSERIALJTAG_INTSTATUSREG_GET_LINE_CODE_INT;
+    refresh(0);
+    dispatch();
+}
+
+void usbSerialJtag_simHostSetControl(uint32_t dtr, uint32_t rts)
+{
+    uint32_t next = (dtr ? mUSBSERIALJTAG_CHIPRSTREG_JTAG_DTR : 0U) | (rts ? mUSBSERIALJTAG_CHIPRSTREG_JTAG_RTS : 0U);
+
+    sync();
+    if ((next ^ control) & mUSBSERIALJTAG_CHIPRSTREG_JTAG_DTR) {
+        raw |= mUSBSERIALJTAG_INTSTATUSREG_DTR_CHG_INT;
+    }
+    if ((next ^ control) & mUSBSERIALJTAG_CHIPRSTREG_JTAG_RTS) {
+        raw |= mUSBSERIALJTAG_INTSTATUSREG_RTS_CHG_INT;
+    }
+    control = next;
+    refresh(0);
+    dispatch();
+}
+
+void usbSerialJtag_simHostBusReset(void)
+{
+    sync();
+    inCount = inBusy = 0;
+    inRd = inWr;
+    outCount = outPos = 0;
+    outRd = outWr;
+    raw |= mUSBSERIALJTAG_INTSTATUSREG_USB_BUS_RESET_INT;
+    refresh(0);
+    dispatch();
+}
+
+void usbSerialJtag_simAdvance(uint32_t delta)
+{
+    cycles += delta;
+}
+
+uint32_t usbSerialJtag_simCycles(void)
+{
+    return cycles;
+}
+
+void usbSerialJtag_simGetStats(__usbSerialJtag_simStats_t *out)
+{
+    *out = stats;
+}
+
+uint32_t usbSerialJtag_simRead(const volatile uint32_t *reg)
+{
+    sync();
+    if (reg == &regs->ep1Reg.WORD) {
+        uint8_t byte = outPop();
+        refresh(0);
+        return byte;
+    }
+    return *reg;
+}
+
+void usbSerialJtag_simWrite(volatile uint32_t *reg, uint32_t value)
+{
+    sync();
+    writeWord(reg, value);
+    dispatch();
+}
+
+void usbSerialJtag_simAmo(volatile uint32_t *reg)
+{
+    // The AMO already updated the model memory, the RO bits it touched are restored by the refresh
+    (void) reg;
+    sync();
+    dispatch();
+}
+
+void *usbSerialJtag_simDirect(const char *function)
+{
+#if USB_SERIAL_JTAG_CFG_TRACE_ENABLE
+    (void) usbSerialJtag_traceDirect(function);
+#else
+    (void) function;
+#endif
+    sync();
+    return regs;
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+/**
+ * @file usb_serial_jtag_sim.h
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Host register model of the ESP32-C6 USB Serial JTAG Controller
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This header file declarates a behavioral model of __usbSerialJtag_t for host builds. The driver
+ * sources are compiled unchanged with USB_SERIAL_JTAG_CFG_SIM_ENABLE set to 1 and linked with
+ * sim/usb_serial_jtag_sim.c; the test program plays the USB host with the usbSerialJtag_simHost*
+ * functions:
+ *
+ *     cc -DUSB_SERIAL_JTAG_CFG_SIM_ENABLE=1 -I. test.c sim/usb_serial_jtag_sim.c USB_SERIAL_JTAG_ESP32-C6_*.c
+ *
+ *     usbSerialJtag_simReset();
+ *     usbSerialJtag_simSetIsr(usbSerialJtag_isrHandler);
+ *     usbSerialJtag_isrInit();
+ *     usbSerialJtag_isrWrite(buf, len);
+ *     while ((n = usbSerialJtag_simHostIn(pkt, sizeof(pkt))) >= 0) { ... }
+ *
+ * sim/usb_serial_jtag_sim_test.c is such a program: it checks the model and the packet batching of
+ * the bulk and interrupt driven data paths.
+ *
+ * Modeled behavior:
+ *
+ * - EP1 IN FIFO of 64 bytes. The bytes written to the FIFO are sent as one packet
+ *   on WR_DONE, SERIAL_IN_EP_DATA_FREE is 0 from WR_DONE until the host reads the packet (and
+ *   while the FIFO is full). Bytes written without space are dropped, as on the hardware.
+ * - EP1 OUT FIFO of 64 bytes. A host packet is accepted when the FIFO is empty (NAK otherwise)
+ *   and raises OUT_RECV_PKT_INT, reading the FIFO pops a byte. EP1_REC_DATA_CNT holds the length
+ *   of the packet in the FIFO until the next one is accepted.
+ * - The interrupt RAW bits are set by the modeled events, IN_EMPTY_INT is set again while the IN
+ *   FIFO is empty and idle. The RAW register is write 1 to clear, INT_CLR clears them, INT_ST is
+ *   RAW & ENA. The ISR registered with usbSerialJtag_simSetIsr is called, like an interrupt, while
+ *   INT_ST is not 0 after a register write, an atomic macro or a host event.
+ * - The WT bits (WR_DONE, INT_CLR, CONFIG_UPDATE) read as 0, the RO registers and bits are owned
+ *   by the model and the writes to them are ignored. The other registers are plain memory.
+ *
+ * The r/b macros access the model memory after a synchronization call, so a bitfield write is
+ * seen at the next access. A plain memory access does not tell a load from a store, so the EP1
+ * FIFO is only accessed with usbSerialJtag_hwEp1Push and usbSerialJtag_hwEp1Pop (and the
+ * push/pop macros built on them): the register hooks get the address of ep1Reg with the
+ * direction. rUSB_SERIAL_JTAG_EP1 and bUSB_SERIAL_JTAG_RDWR_BYTE do not build.
+ *
+ * Time is virtual: usbSerialJtag_simCycles advances by one frame of cycles per SOF, by a few
+ * cycles per register access (so a polling loop bounded in time ends) and by
+ * usbSerialJtag_simAdvance.
+ *
+ */
+
+#ifndef USB_SERIAL_JTAG_SIM_H
+#define USB_SERIAL_JTAG_SIM_H
+
+#include <stdint.h>
+
+#include "../USB_SERIAL_JTAG_ESP32-C6_CONFIG.h"
+
+#if defined(__riscv)
+#error "The USB Serial JTAG register model is for host builds only"
+#endif
+
+/**
+ * \typedef __usbSerialJtag_simStats_t
+ * Counters of the register model
+ */
+typedef struct {
+    uint32_t inPackets; // IN packets read by the host
+    uint32_t inBytes; // Payload of the IN packets
+    uint32_t inNaks; // IN tokens without a packet ready
+    uint32_t inOverflow; // Bytes written to the IN FIFO without space (dropped)
+    uint32_t outPackets; // OUT packets accepted
+    uint32_t outBytes; // Payload of the OUT packets
+    uint32_t outNaks; // OUT packets refused, the FIFO was not empty
+    uint32_t outUnderflow; // Reads of the empty OUT FIFO
+    uint32_t wrDone; // WR_DONE writes
+    uint32_t configUpdates; // CONFIG_UPDATE writes
+    uint32_t isrCalls; // ISR dispatches
+    uint32_t irqStorms; // Dispatch loops stopped with INT_ST still set
+    uint32_t accesses; // Register accesses (helpers, atomic macros, r/b macros)
+} __usbSerialJtag_simStats_t;
+
+
+/**
+ * @brief Reset the model: reset values, empty FIFOs, counters at 0, no ISR
+ */
+void usbSerialJtag_simReset(void);
+
+/**
+ * @brief Register the interrupt handler of the model
+ *
+ * @param isr Handler (usbSerialJtag_isrHandler), NULL to poll INT_ST instead
+ */
+void usbSerialJtag_simSetIsr(void (*isr)(void));
+
+/**
+ * @brief Call the ISR while INT_ST is not 0
+ */
+void usbSerialJtag_simPoll(void);
+
+/**
+ * @brief Host IN token on EP1
+ *
+ * @param buf Packet (64 bytes)
+ * @param max Size of buf
+ * @return int Packet length (0 for a zero length packet), -1 for a NAK
+ */
+int usbSerialJtag_simHostIn(uint8_t *buf, uint32_t max);
+
+/**
+ * @brief Host OUT packet on EP1
+ *
+ * @param buf Packet
+ * @param len Packet length, up to 64 bytes
+ * @return int 0 on success, -1 for a NAK (the FIFO is not empty, or len is too long)
+ */
+int usbSerialJtag_simHostOut(const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Host start of frame: next frame index, SOF_INT, one frame of virtual time
+ */
+void usbSerialJtag_simHostSof(void);
+
+/**
+ * @brief Host SET_LINE_CODING request
+ */
+void usbSerialJtag_simHostSetLine(uint32_t dteRate, uint8_t charFormat, uint8_t parityType, uint8_t dataBits);
+
+/**
+ * @brief Host GET_LINE_CODING request
+ *
+ * @param w0 GET_LINE_CODE_W0 value (dwDTERate)
+ * @param w1 GET_LINE_CODE_W1 value (bDataBits, bParityType, bCharFormat)
+ */
+void usbSerialJtag_simHostGetLine(uint32_t *w0, uint32_t *w1);
+
+/**
+ * @brief Host SET_CONTROL_LINE_STATE request, raises DTR_CHG_INT and RTS_CHG_INT on a change
+ */
+void usbSerialJtag_simHostSetControl(uint32_t dtr, uint32_t rts);
+
+/**
+ * @brief Host bus reset: the FIFOs are flushed, USB_BUS_RESET_INT
+ */
+void usbSerialJtag_simHostBusReset(void);
+
+/**
+ * @brief Advance the virtual time
+ *
+ * @param cycles CPU cycles
+ */
+void usbSerialJtag_simAdvance(uint32_t cycles);
+
+/**
+ * @brief Read the virtual time (cycle counter of USB_SERIAL_JTAG_ESP32-C6_PORT.h)
+ *
+ * @return uint32_t CPU cycles
+ */
+uint32_t usbSerialJtag_simCycles(void);
+
+/**
+ * @brief Get the counters of the model
+ *
+ * @param out Copy of the counters
+ */
+void usbSerialJtag_simGetStats(__usbSerialJtag_simStats_t *out);
+
+/**
+ * Register access hooks, called by USB_SERIAL_JTAG_ESP32-C6_LIB.h
+ */
+uint32_t usbSerialJtag_simRead(const volatile uint32_t *reg);
+void usbSerialJtag_simWrite(volatile uint32_t *reg, uint32_t value);
+void usbSerialJtag_simAmo(volatile uint32_t *reg);
+void *usbSerialJtag_simDirect(const char *function);
+
+#endif // USB_SERIAL_JTAG_SIM_H
\ No newline at end of file
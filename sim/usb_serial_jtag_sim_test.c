@@ -0,0 +1,370 @@
+/**
+ * @file usb_serial_jtag_sim_test.c
+ * @author Cristian David Araujo A. (cristian.araujo@udea.edu.co)
+ * @brief Host tests of the CDC-ACM data path on the register model
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Unlicensed
+ *
+ * This file checks the register model, the packet batching of the bulk and interrupt driven data
+ * paths and the RX flow control of the interrupt driver at host speed. The checks of the optional
+ * paths (RX moderation, firmware update) are built when their option is enabled. Build and run it with the driver sources:
+ *
+ *     cc -DUSB_SERIAL_JTAG_CFG_SIM_ENABLE=1 -I. sim/usb_serial_jtag_sim_test.c sim/usb_serial_jtag_sim.c USB_SERIAL_JTAG_ESP32-C6_*.c
+ *     ./a.out
+ *
+ * Every failed check is printed, the exit status is the number of failed checks.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "USB_SERIAL_JTAG_ESP32-C6_CDC.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_ISR.h"
+#include "USB_SERIAL_JTAG_ESP32-C6_OTA.h"
+#include "usb_serial_jtag_sim.h"
+
+#define CHECK(cond) check((cond), #cond, __func__, __LINE__)
+
+static uint32_t failed = 0;
+static uint8_t src[3000];
+static uint8_t dst[3000];
+
+
+static void check(int cond, const char *expr, const char *function, int line)
+{
+    if (!cond) {
+        printf("FAIL %s:%d %s\n", function, line, expr);
+        failed++;
+    }
+}
+
+static __usbSerialJtag_simStats_t simStats(void)
+{
+    __usbSerialJtag_simStats_t st;
+    usbSerialJtag_simGetStats(&st);
+    return st;
+}
+
+/**
+ * @brief WT, RO and write 1 to clear semantics of the model
+ */
+static void testRegisters(void)
+{
+    usbSerialJtag_simReset();
+
+    // DATA_FREE is RO, the model keeps it
+    bUSB_SERIAL_JTAG_SERIAL_IN_EP_DATA_FREE = 0;
+    CHECK(bUSB_SERIAL_JTAG_SERIAL_IN_EP_DATA_FREE == 1);
+
+    // WR_DONE is WT: it reads as 0 and commits a packet, the FIFO is busy until the host reads it
+    bUSB_SERIAL_JTAG_WR_DONE = 1;
+    CHECK(bUSB_SERIAL_JTAG_WR_DONE == 0);
+    CHECK(simStats().wrDone == 1);
+    CHECK(bUSB_SERIAL_JTAG_SERIAL_IN_EP_DATA_FREE == 0);
+
+    CHECK(usbSerialJtag_simHostOut(src, 8) == 0);
+    CHECK((usbSerialJtag_intRawSnapshot().WORD & mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT) != 0);
+    setUSB_SERIAL_JTAG_INT_CLR(mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT);
+    CHECK((usbSerialJtag_intRawSnapshot().WORD & mUSBSERIALJTAG_INTSTATUSREG_OUT_RECV_PKT_INT) == 0);
+    CHECK(usbSerialJtag_outEp1StSnapshot().BITS.EP1_REC_DATA_CNT == 8);
+}
+
+/**
+ * @brief A write of the byte the OUT FIFO holds next is a write, not a read
+ */
+static void testEp1Direction(void)
+{
+    uint8_t out[2] = { 'A', 0 };
+    uint8_t in[64];
+
+    usbSerialJtag_simReset();
+    CHECK(usbSerialJtag_simHostOut(out, sizeof(out)) == 0);
+
+    pushUSB_SERIAL_JTAG_EP1('A');
+    pushUSB_SERIAL_JTAG_EP1(0);
+    usbSerialJtag_txFlush(usbSerialJtag_hw());
+    CHECK(usbSerialJtag_simHostIn(in, sizeof(in)) == 2);
+    CHECK(in[0] == 'A' && in[1] == 0);
+    CHECK(bUSB_SERIAL_JTAG_SERIAL_OUT_EP_DATA_AVAIL == 1);
+
+    CHECK((popUSB_SERIAL_JTAG_EP1() & 0xFFU) == 'A');
+    CHECK((popUSB_SERIAL_JTAG_EP1() & 0xFFU) == 0);
+    CHECK(bUSB_SERIAL_JTAG_SERIAL_OUT_EP_DATA_AVAIL == 0);
+
+    // A 0 pushed while the OUT FIFO is empty
+    pushUSB_SERIAL_JTAG_EP1(0);
+    usbSerialJtag_txFlush(usbSerialJtag_hw());
+    CHECK(usbSerialJtag_simHostIn(in, sizeof(in)) == 1);
+    CHECK(simStats().outUnderflow == 0);
+}
+
+/**
+ * @brief The bulk writer commits one packet per 64 bytes, the reader drains a packet per count read
+ */
+static void testBulkBatching(void)
+{
+    uint8_t pkt[64];
+    size_t sent = 0;
+    size_t got = 0;
+
+    usbSerialJtag_simReset();
+    while (sent < 1000) {
+        sent += usbSerialJtag_write(usbSerialJtag_hw(), &src[sent], 1000 - sent);
+        int len = usbSerialJtag_simHostIn(pkt, sizeof(pkt));
+        CHECK(len > 0);
+        if (len <= 0) {
+            break;
+        }
+        memcpy(&dst[got], pkt, (size_t) len);
+        got += (size_t) len;
+    }
+    CHECK(got == 1000 && memcmp(dst, src, 1000) == 0);
+    CHECK(simStats().wrDone == 16);
+    CHECK(simStats().inOverflow == 0);
+
+    // A packet read in two calls is counted once
+    uint32_t packets = usbSerialJtag_rxPacketCount();
+    CHECK(usbSerialJtag_simHostOut(src, 64) == 0);
+    CHECK(usbSerialJtag_read(usbSerialJtag_hw(), dst, 40) == 40);
+    CHECK(usbSerialJtag_read(usbSerialJtag_hw(), &dst[40], 64) == 24);
+    CHECK(usbSerialJtag_read(usbSerialJtag_hw(), dst, 64) == 0);
+    CHECK(memcmp(dst, src, 64) == 0);
+    CHECK(usbSerialJtag_rxPacketCount() - packets == 1);
+}
+
+/**
+ * @brief The interrupt driver sends full packets and drains every OUT packet in its ISR entry
+ */
+static void testIsrBatching(void)
+{
+    uint8_t pkt[64];
+    size_t queued = 0;
+    size_t got = 0;
+
+    usbSerialJtag_simReset();
+    usbSerialJtag_simSetIsr(usbSerialJtag_isrHandler);
+    usbSerialJtag_isrInit();
+
+    for (uint32_t i = 0; got < sizeof(src) && i < 1000; i++) {
+        queued += usbSerialJtag_isrWrite(&src[queued], sizeof(src) - queued);
+        int len = usbSerialJtag_simHostIn(pkt, sizeof(pkt));
+        if (len > 0) {
+            memcpy(&dst[got], pkt, (size_t) len);
+            got += (size_t) len;
+        }
+    }
+    CHECK(got == sizeof(src) && memcmp(dst, src, sizeof(src)) == 0);
+    CHECK(simStats().wrDone == (sizeof(src) + 63U) / 64U);
+
+#if !USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+    // The moderated RX path is checked by testRxModeration
+    uint32_t calls = simStats().isrCalls;
+    got = 0;
+    for (uint32_t i = 0; i < 16; i++) {
+        CHECK(usbSerialJtag_simHostOut(&src[i * 64U], 64) == 0);
+        got += usbSerialJtag_isrRead(&dst[got], sizeof(dst) - got);
+    }
+    CHECK(got == 1024 && memcmp(dst, src, 1024) == 0);
+    CHECK(simStats().isrCalls - calls <= 16);
+    CHECK(simStats().outNaks == 0);
+#endif
+
+    usbSerialJtag_isrDeinit();
+}
+
+/**
+ * @brief A packet left in the FIFO by a full RX ring is moved by the ISR once a read freed room
+ */
+static void testRxStall(void)
+{
+    uint32_t sent = 0;
+    size_t got = 0;
+
+    usbSerialJtag_simReset();
+    usbSerialJtag_simSetIsr(usbSerialJtag_isrHandler);
+    usbSerialJtag_isrInit();
+    usbSerialJtag_isrSetRxModeration(0, 0);
+
+    while (sent < 16 && usbSerialJtag_simHostOut(&src[sent * 64U], 64) == 0) {
+        sent++;
+    }
+    CHECK(sent == USB_SERIAL_JTAG_CFG_RX_RING_SIZE / 64U + 1U);
+
+    // The read frees room, the FIFO is drained on the next frame
+    got = usbSerialJtag_isrRead(dst, 64);
+    CHECK(got == 64);
+    CHECK(usbSerialJtag_simHostOut(&src[sent * 64U], 64) != 0);
+    usbSerialJtag_simHostSof();
+    CHECK(usbSerialJtag_simHostOut(&src[sent * 64U], 64) == 0);
+    sent++;
+
+    for (uint32_t i = 0; i < 4 && got < sent * 64U; i++) {
+        size_t n;
+        while ((n = usbSerialJtag_isrRead(&dst[got], sizeof(dst) - got)) != 0) {
+            got += n;
+        }
+        usbSerialJtag_simHostSof();
+    }
+    CHECK(got == sent * 64U && memcmp(dst, src, got) == 0);
+
+    usbSerialJtag_isrDeinit();
+}
+
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+/**
+ * @brief A moderation round drains the burst from SOF_INT and ends without any read
+ */
+static void testRxModeration(void)
+{
+    usbSerialJtag_simReset();
+    usbSerialJtag_simSetIsr(usbSerialJtag_isrHandler);
+    usbSerialJtag_isrInit();
+    usbSerialJtag_isrSetRxModeration(8, 200);
+
+    // The first packet starts the round, the second one waits in the FIFO without an ISR entry
+    uint32_t calls = simStats().isrCalls;
+    CHECK(usbSerialJtag_simHostOut(&src[0], 64) == 0);
+    CHECK(usbSerialJtag_simHostOut(&src[64], 64) == 0);
+    CHECK(usbSerialJtag_simHostOut(&src[128], 64) != 0);
+    CHECK(simStats().isrCalls - calls == 1);
+
+    // The frame ends the round past its time limit, no read is needed
+    usbSerialJtag_simHostSof();
+    CHECK(usbSerialJtag_simHostOut(&src[128], 64) == 0);
+    usbSerialJtag_simHostSof();
+    usbSerialJtag_simHostSof();
+    CHECK(usbSerialJtag_isrRxAvailable() == 192);
+
+    // An idle frame closes the round, the next packet is taken by its own ISR entry
+    calls = simStats().isrCalls;
+    CHECK(usbSerialJtag_simHostOut(&src[192], 64) == 0);
+    CHECK(simStats().isrCalls - calls == 1);
+    CHECK(usbSerialJtag_isrRead(dst, sizeof(dst)) == 256);
+    CHECK(memcmp(dst, src, 256) == 0);
+
+    usbSerialJtag_isrDeinit();
+}
+#endif
+
+#if USB_SERIAL_JTAG_CFG_OTA_ENABLE
+static uint8_t flash[3U * USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE]; // Erased a page at a time
+
+static int flashErase(uint32_t addr, uint32_t len, void *arg)
+{
+    (void) arg;
+    memset(&flash[addr], 0xFF, len);
+    return 0;
+}
+
+static int flashProgram(uint32_t addr, const uint8_t *data, uint32_t len, void *arg)
+{
+    (void) arg;
+    memcpy(&flash[addr], data, len);
+    return 0;
+}
+
+static uint8_t imageByte(uint32_t i)
+{
+    return (uint8_t) (i * 13U + 5U);
+}
+
+static int hostOutImage(uint32_t off)
+{
+    uint8_t pkt[64];
+
+    for (uint32_t i = 0; i < sizeof(pkt); i++) {
+        pkt[i] = imageByte(off + i);
+    }
+    return usbSerialJtag_simHostOut(pkt, sizeof(pkt));
+}
+
+static int ringMatches(const uint8_t *buf, size_t len, uint32_t off)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != imageByte(off + (uint32_t) i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint32_t otaRun(void)
+{
+    uint32_t state = kUSB_SERIAL_JTAG_OTA_RECEIVING;
+
+    for (uint32_t i = 0; i < 64 && state == kUSB_SERIAL_JTAG_OTA_RECEIVING; i++) {
+        state = usbSerialJtag_otaPoll();
+    }
+    return state;
+}
+
+/**
+ * @brief The bytes that follow the image in its last packet go to the RX ring
+ */
+static void testOtaTail(void)
+{
+    const __usbSerialJtag_otaFlash_t hooks = { flashErase, flashProgram, NULL };
+    const uint32_t size = 2U * USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE + 36U;
+    uint32_t sent = 0;
+    size_t got;
+
+    // ISR path: a 100-byte image sent as two full packets
+    usbSerialJtag_simReset();
+    usbSerialJtag_simSetIsr(usbSerialJtag_isrHandler);
+    usbSerialJtag_isrInit();
+    CHECK(usbSerialJtag_otaBegin(&hooks, 0, 100) == 0);
+    CHECK(hostOutImage(0) == 0);
+    CHECK(hostOutImage(64) == 0);
+    CHECK(otaRun() == kUSB_SERIAL_JTAG_OTA_DONE);
+    CHECK(hostOutImage(128) == 0);
+    usbSerialJtag_simHostSof();
+    got = usbSerialJtag_isrRead(dst, sizeof(dst));
+    CHECK(got == 92 && ringMatches(dst, got, 100));
+    CHECK(ringMatches(flash, 100, 0));
+    usbSerialJtag_isrDeinit();
+
+    // Task path: the packet that ends the image is held in the FIFO while both buffers wait
+    usbSerialJtag_simReset();
+    usbSerialJtag_simSetIsr(usbSerialJtag_isrHandler);
+    usbSerialJtag_isrInit();
+    CHECK(usbSerialJtag_otaBegin(&hooks, 0, size) == 0);
+    while (sent < size && hostOutImage(sent) == 0) {
+        sent += 64U;
+    }
+    CHECK(sent == 2U * USB_SERIAL_JTAG_CFG_OTA_PAGE_SIZE + 64U);
+    CHECK(otaRun() == kUSB_SERIAL_JTAG_OTA_DONE);
+    usbSerialJtag_simHostSof();
+    CHECK(hostOutImage(sent) == 0);
+    usbSerialJtag_simHostSof();
+    got = usbSerialJtag_isrRead(dst, sizeof(dst));
+    CHECK(got == 92 && ringMatches(dst, got, size));
+    CHECK(ringMatches(flash, size, 0));
+    usbSerialJtag_isrDeinit();
+}
+#endif
+
+
+int main(void)
+{
+    for (uint32_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t) (i * 7U + 1U);
+    }
+
+    testRegisters();
+    testEp1Direction();
+    testBulkBatching();
+    testIsrBatching();
+    testRxStall();
+#if USB_SERIAL_JTAG_CFG_RX_MOD_ENABLE
+    testRxModeration();
+#endif
+#if USB_SERIAL_JTAG_CFG_OTA_ENABLE
+    testOtaTail();
+#endif
+
+    printf("%s: %u failed\n", failed ? "FAIL" : "PASS", failed);
+    return (int) failed;
+}
\ No newline at end of file
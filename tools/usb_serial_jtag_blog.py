@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Host decoder of the ESP32-C6 USB Serial JTAG binary log (see USB_SERIAL_JTAG_ESP32-C6_BLOG.h).
+
+The format strings are taken from the .usbSerialJtagFmt section of the ELF file of the
+application, the records are read from the CDC-ACM port (or a capture file) and expanded with the
+string table.
+
+Record, little endian: 0xA0 | N, ID (u16), timestamp (u32), N argument words (u32). The ID is the
+low 16 bits of the address of the string, the timestamp holds the SOF frame index (bits 16-26) and
+the sequence number of the record in that frame (bits 0-15).
+
+Usage:
+    usb_serial_jtag_blog.py app.elf /dev/ttyACM0
+    usb_serial_jtag_blog.py app.elf capture.bin
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SECTION = ".usbSerialJtagFmt"
+TAG = 0xA0
+HDR_SIZE = 7
+MAX_ARGS = 15
+FRAME_WRAP = 2048
+
+SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diuxXoscpfFeEgG%])")
+
+
+def elf_section(path, name):
+    """Return (address, data) of a section, minimal ELF32/ELF64 little endian reader."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[5] != 1:
+        raise ValueError("%s is not a little endian ELF file" % path)
+    if elf[4] == 1:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+        fmt, fields = "<IIIIII", (0, 3, 4, 5)  # name, addr, offset, size
+    else:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+        fmt, fields = "<IIQQQQ", (0, 3, 4, 5)
+
+    def header(i):
+        sh = struct.unpack_from(fmt, elf, shoff + i * shentsize)
+        return [sh[k] for k in fields]
+
+    _, _, stroff, _ = header(shstrndx)
+    for i in range(shnum):
+        sname, addr, off, size = header(i)
+        end = elf.index(b"\0", stroff + sname)
+        if elf[stroff + sname:end].decode() == name:
+            return addr, elf[off:off + size]
+    raise ValueError("%s has no %s section" % (path, name))
+
+
+def string_table(path):
+    addr, data = elf_section(path, SECTION)
+    table = {}
+    for i, byte in enumerate(data):
+        if byte and (i == 0 or data[i - 1] == 0):
+            end = data.index(b"\0", i)
+            table[(addr + i) & 0xFFFF] = data[i:end].decode("utf-8", "replace")
+    return table
+
+
+def expand(fmt, args):
+    """Apply a C format string to the raw argument words."""
+    words = list(args)
+
+    def repl(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        if not words:
+            return m.group(0)
+        w = words.pop(0)
+        spec = "%" + flags + width + ("." + prec if prec is not None else "")
+        if conv in "di":
+            return (spec + "d") % (w - (1 << 32) if w & 0x80000000 else w)
+        if conv == "u":
+            return (spec + "d") % w
+        if conv in "xXo":
+            return (spec + conv) % w
+        if conv == "c":
+            return (spec + "c") % chr(w & 0xFF)
+        if conv in "fFeEgG":
+            return (spec + conv) % struct.unpack("<f", struct.pack("<I", w))[0]
+        # %s and %p: device addresses, the strings are not on the host
+        return "0x%08x" % w
+
+    return SPEC.sub(repl, fmt)
+
+
+class Decoder:
+    def __init__(self, table):
+        self.table = table
+        self.buf = bytearray()
+        self.last_frame = None
+        self.ms = 0
+
+    def timestamp(self, ts):
+        frame, seq = (ts >> 16) & (FRAME_WRAP - 1), ts & 0xFFFF
+        if self.last_frame is not None:
+            self.ms += (frame - self.last_frame) % FRAME_WRAP
+        self.last_frame = frame
+        return "%10d.%03d" % (self.ms, seq)
+
+    def feed(self, data):
+        self.buf += data
+        out = []
+        while len(self.buf) >= HDR_SIZE:
+            tag = self.buf[0]
+            n = tag & 0x0F
+            fid, = struct.unpack_from("<H", self.buf, 1)
+            if tag & 0xF0 != TAG or fid not in self.table:
+                del self.buf[0]  # Resynchronize on the next valid record
+                continue
+            size = HDR_SIZE + 4 * n
+            if len(self.buf) < size:
+                break
+            ts, = struct.unpack_from("<I", self.buf, 3)
+            args = struct.unpack_from("<%dI" % n, self.buf, HDR_SIZE)
+            del self.buf[:size]
+            out.append("%s %s" % (self.timestamp(ts), expand(self.table[fid], args)))
+        return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("elf")
+    ap.add_argument("source", help="serial port or capture file")
+    args = ap.parse_args()
+
+    dec = Decoder(string_table(args.elf))
+    if os.path.isfile(args.source):
+        with open(args.source, "rb") as f:
+            for line in dec.feed(f.read()):
+                print(line)
+        return 0
+
+    try:
+        import serial
+    except ImportError:  # pragma: no cover
+        sys.exit("pyserial is required: pip install pyserial")
+    with serial.Serial(args.source, timeout=0.1) as port:
+        while True:
+            for line in dec.feed(port.read(port.in_waiting or 1)):
+                print(line, flush=True)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
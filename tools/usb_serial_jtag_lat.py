@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Host decoder of the ESP32-C6 USB Serial JTAG latency histograms (see USB_SERIAL_JTAG_ESP32-C6_LAT.h).
+
+The block written by usbSerialJtag_latExport is searched in the CDC-ACM stream (or a capture
+file) and the percentiles of every path are printed in microseconds, as upper bounds of the
+buckets like usbSerialJtag_latPercentile.
+
+Block, little endian words: "LATH", CPU frequency in Hz, paths | sub bits << 8 | buckets << 16,
+then per path: count, max, buckets.
+
+Usage:
+    usb_serial_jtag_lat.py /dev/ttyACM0
+    usb_serial_jtag_lat.py capture.bin
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"LATH"
+HDR_SIZE = 12
+PATHS = ("isr", "rx", "tx", "app")
+PERCENTILES = (500, 900, 990, 999)
+
+
+def bucket_low(b, sub):
+    if b < (1 << sub):
+        return b
+    msb = (b >> sub) + sub - 1
+    return ((1 << sub) | (b & ((1 << sub) - 1))) << (msb - sub)
+
+
+def percentile(count, top, buckets, sub, permille):
+    rank = max(1, (count * permille + 999) // 1000)
+    seen = 0
+    for b, n in enumerate(buckets):
+        seen += n
+        if seen >= rank:
+            high = bucket_low(b + 1, sub) - 1 if b + 1 < len(buckets) else 0xFFFFFFFF
+            return min(high, top)
+    return top
+
+
+def parse(data):
+    """Return (block size, report lines) of the block at the start of data, None if incomplete."""
+    if len(data) < HDR_SIZE:
+        return None
+    _, hz, layout = struct.unpack_from("<4sII", data)
+    paths, sub, nb = layout & 0xFF, (layout >> 8) & 0xFF, layout >> 16
+    size = HDR_SIZE + paths * (8 + 4 * nb)
+    if len(data) < size:
+        return None
+
+    us = hz / 1e6
+    lines = ["%-5s %10s %10s %10s %10s %10s %10s" % ("path", "count", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us")]
+    pos = HDR_SIZE
+    for p in range(paths):
+        count, top = struct.unpack_from("<II", data, pos)
+        buckets = struct.unpack_from("<%dI" % nb, data, pos + 8)
+        pos += 8 + 4 * nb
+        name = PATHS[p] if p < len(PATHS) else str(p)
+        if count == 0:
+            lines.append("%-5s %10d" % (name, 0))
+            continue
+        cols = ["%10.2f" % (percentile(count, top, buckets, sub, pm) / us) for pm in PERCENTILES]
+        lines.append("%-5s %10d %s %10.2f" % (name, count, " ".join(cols), top / us))
+    return size, lines
+
+
+class Decoder:
+    def __init__(self):
+        self.buf = bytearray()
+
+    def feed(self, data):
+        self.buf += data
+        out = []
+        while True:
+            i = self.buf.find(MAGIC)
+            if i < 0:
+                del self.buf[:max(0, len(self.buf) - len(MAGIC) + 1)]
+                return out
+            del self.buf[:i]
+            res = parse(bytes(self.buf))
+            if res is None:
+                return out
+            size, lines = res
+            del self.buf[:size]
+            out.extend(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("source", help="serial port or capture file")
+    args = ap.parse_args()
+
+    dec = Decoder()
+    if os.path.isfile(args.source):
+        with open(args.source, "rb") as f:
+            for line in dec.feed(f.read()):
+                print(line)
+        return 0
+
+    try:
+        import serial
+    except ImportError:  # pragma: no cover
+        sys.exit("pyserial is required: pip install pyserial")
+    with serial.Serial(args.source, timeout=0.1) as port:
+        while True:
+            for line in dec.feed(port.read(port.in_waiting or 1)):
+                print(line, flush=True)
+
+
+if __name__ == "__main__":
+    sys.exit(main())